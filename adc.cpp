@@ -4,13 +4,26 @@
 #include "dac.h"
 #include "adc.h"
 
-ADCPtr *ADCS = new ADCPtr[NUMBERADCS]();
+ADCPtr ADCS[NUMBERADCS];
+
+LTC1859::LTC1859(void)
+{
+}
 
 LTC1859::LTC1859(int8_t adcnum,
                  typeof(SPI) *spi,
                  typeof(DigitalOut) *spinss,
                  typeof(DigitalIn) *busy,
                  voltspan span)
+{
+    Init(adcnum, spi, spinss, busy, span);
+}
+
+void LTC1859::Init(int8_t adcnum,
+                   typeof(SPI) *spi,
+                   typeof(DigitalOut) *spinss,
+                   typeof(DigitalIn) *busy,
+                   voltspan span)
 {
     m_adcnum = adcnum & 0xf; // only 16 ADCs (2x8) per board
     m_spi = spi;
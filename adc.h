@@ -6,7 +6,7 @@
 class LTC1859;
 #define NUMBERADCS 16
 typedef LTC1859 *ADCPtr;
-extern ADCPtr *ADCS;
+extern ADCPtr ADCS[NUMBERADCS];
 
 // The LTC1859 is a 8-channel 16-bit ADC with programmable span connected through SPI.
 class LTC1859
@@ -21,7 +21,9 @@ class LTC1859
     uint16_t m_vin, m_dataword;
 
   public:
+    LTC1859(void); // for the statically placed board arrays, Init before use
     LTC1859(int8_t adcnum, typeof(SPI) *spi, typeof(DigitalOut) *spi_nss, typeof(DigitalIn) *busy, voltspan span);
+    void Init(int8_t adcnum, typeof(SPI) *spi, typeof(DigitalOut) *spi_nss, typeof(DigitalIn) *busy, voltspan span);
     void Setspan(voltspan span);
     uint16_t Vin1(void);
     void Vchk(void);
@@ -0,0 +1,495 @@
+// autotune.cpp ... Autotune class which tunes the tritone offsets of all VCOs at the same time
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "dacbus.h"
+#include "autotune.h"
+
+Autotune::Autotune(void)
+{
+    m_count = 0;
+    m_running = false, m_runs = 0;
+    m_cycles = 0, m_measurements = 0, m_ms = 0;
+}
+
+void Autotune::Start(TuneState *state, int8_t tritone)
+{ // the offset of the tritone below is the first guess
+    OctaveXstep ox = state->vco->Tritone(tritone);
+    state->tritone = tritone;
+    state->targetdin = state->vco->Dinx(ox.octave, ox.xstep);
+    state->cnt = 0;
+    state->phase = TuneOutput;
+}
+
+void Autotune::Finish(TuneState *state, bool printit)
+{ // keep the converged offset, otherwise the average of the measured ones
+    int32_t total = 0;
+    if (state->cnt && !(state->cnt > 1 && state->offsets[state->cnt - 2] == state->offsets[state->cnt - 1]))
+    {
+        for (int8_t i = 0; i < state->cnt; i++)
+            total += state->offsets[i];
+        state->offset = (total + state->cnt / 2) / state->cnt;
+    }
+    state->vco->Setoffset(state->tritone, state->cnt ? state->offset : 0);
+    if (printit)
+        printf("%2d %2d %5d %s", state->tritone, state->cnt, state->offset, state->vco->Getoffsets());
+    Next(state, printit);
+}
+
+void Autotune::Next(TuneState *state, bool printit)
+{ // in fit mode the model's offset is the first guess, and is checked against what is measured
+    uint32_t bit = 1UL << state->tritone;
+    int8_t tritone;
+    if (!state->fit)
+    {
+        if (state->tritone >= TUNE_LAST)
+            state->phase = TuneDone;
+        else
+            Start(state, state->tritone + 1);
+        return;
+    }
+    state->tried |= bit;
+    if (state->cnt)
+    {
+        state->measured |= bit;
+        state->measuredoffsets[state->tritone] = state->offset;
+        state->points++;
+        if (state->predicting && state->points >= AUTOTUNE_FITMIN &&
+            abs(state->offset - state->predicted) <= AUTOTUNE_FITTOL)
+        {
+            Fill(state, printit);
+            return;
+        }
+    }
+    state->predicting = Fit(state);
+    if ((tritone = Nexttritone(state)) < 0)
+    {
+        Fill(state, printit);
+        return;
+    }
+    Start(state, tritone);
+    if (state->predicting)
+        state->offset = state->predicted = Predict(state, tritone);
+}
+
+int8_t Autotune::Nexttritone(TuneState *state)
+{ // the ends of the tuned range, then the middle of the widest gap between the tried tritones
+    int8_t tritone, below = TUNE_FIRST, widest = 1, next = -1;
+    if (!(state->tried & (1UL << TUNE_FIRST)))
+        return (TUNE_FIRST);
+    if (!(state->tried & (1UL << TUNE_LAST)))
+        return (TUNE_LAST);
+    for (tritone = TUNE_FIRST + 1; tritone <= TUNE_LAST; tritone++)
+    {
+        if (!(state->tried & (1UL << tritone)))
+            continue;
+        if (tritone - below > widest)
+            widest = tritone - below, next = (below + tritone) / 2;
+        below = tritone;
+    }
+    return (next);
+}
+
+static void Fitbasis(int8_t tritone, double *phi)
+{ // a constant offset, a scale error which grows with the din and a rolloff which grows with the frequency
+    phi[0] = 1.0;
+    phi[1] = tritone - AUTOTUNE_FITCENTER;
+    phi[2] = pow(2.0, (tritone - TUNE_LAST) / 2.0);
+}
+
+bool Autotune::Fit(TuneState *state)
+{ // least squares of the measured offsets, the normal equations are solved by Gaussian elimination
+    double ata[3][4] = {{0}}; // the last column is the basis times the offsets
+    double phi[3], factor, sum;
+    int8_t tritone, i, j, k, best;
+    if (state->points < 3)
+        return (false);
+    for (tritone = 0; tritone < AUTOTUNE_TRITONES; tritone++)
+    {
+        if (!(state->measured & (1UL << tritone)))
+            continue;
+        Fitbasis(tritone, phi);
+        for (i = 0; i < 3; i++)
+        {
+            for (j = 0; j < 3; j++)
+                ata[i][j] += phi[i] * phi[j];
+            ata[i][3] += phi[i] * state->measuredoffsets[tritone];
+        }
+    }
+    for (i = 0; i < 3; i++)
+    {
+        best = i;
+        for (k = i + 1; k < 3; k++)
+            if (fabs(ata[k][i]) > fabs(ata[best][i]))
+                best = k;
+        if (fabs(ata[best][i]) < 1e-9)
+            return (false);
+        for (j = 0; j < 4; j++) // the largest pivot keeps the elimination accurate
+            factor = ata[i][j], ata[i][j] = ata[best][j], ata[best][j] = factor;
+        for (k = i + 1; k < 3; k++)
+        {
+            factor = ata[k][i] / ata[i][i];
+            for (j = i; j < 4; j++)
+                ata[k][j] -= factor * ata[i][j];
+        }
+    }
+    for (i = 2; i >= 0; i--)
+    {
+        sum = ata[i][3];
+        for (j = i + 1; j < 3; j++)
+            sum -= ata[i][j] * state->model[j];
+        state->model[i] = sum / ata[i][i];
+    }
+    return (true);
+}
+
+int32_t Autotune::Predict(TuneState *state, int8_t tritone)
+{
+    double phi[3], offset;
+    Fitbasis(tritone, phi);
+    offset = state->model[0] * phi[0] + state->model[1] * phi[1] + state->model[2] * phi[2];
+    if (offset > 32767.0)
+        return (32767);
+    if (offset < -32767.0)
+        return (-32767);
+    return ((int32_t)floor(offset + 0.5));
+}
+
+void Autotune::Fill(TuneState *state, bool printit)
+{ // the measured tritones keep their offsets, the model fills the others including the extreme octaves
+    int8_t tritones = state->vco->Gettritones();
+    if (tritones > AUTOTUNE_TRITONES)
+        tritones = AUTOTUNE_TRITONES;
+    if (Fit(state))
+    {
+        for (int8_t tritone = 0; tritone < tritones; tritone++)
+            if (!(state->measured & (1UL << tritone)))
+                state->vco->Setoffset(tritone, Predict(state, tritone));
+        if (printit)
+            printf("fit %d points offset %.1f scale %.2f rolloff %.1f\n\r%s", state->points,
+                   state->model[0], state->model[1], state->model[2], state->vco->Getoffsets());
+    }
+    state->phase = TuneDone; // without a fit Tuneend copies the neighbours as before
+}
+
+static bool Settled(VCO *vco, uint32_t *samples, uint32_t *width, int32_t targetdin, int32_t *freqdin)
+{ // true when a new width has arrived which agrees with the one before it, is confident and is near
+    // the target, *samples and *width are the FreqChannel's sample count and the width last seen
+    FreqChannel *freq = vco->GetFreqChannel();
+    uint32_t previous = *width;
+    FreqSample sample;
+    if (freq->Getsamples() == *samples)
+        return (false);
+    *samples = freq->Getsamples();
+    sample = freq->Median();
+    *width = sample.width;
+    if (!previous || !sample.width || sample.confidence < FREQ_MINCONFIDENCE ||
+        (uint32_t)abs((int32_t)(sample.width - previous)) > (previous >> AUTOTUNE_SETTLE))
+        return (false); // the periods before and after the output changed do not agree yet
+    *freqdin = (int32_t)vco->Dinw(sample.width);
+    return (abs(targetdin - *freqdin) <= AUTOTUNE_OUTLIER);
+}
+
+void Autotune::Harvest(TuneState *state, bool printit)
+{ // take the newest width if the VCO has settled since the output changed, the tritone is given up
+    // AUTOTUNE_TIMEOUT after the output whether or not widths keep arriving
+    int32_t freqdin;
+    if (!Settled(state->vco, &state->samples, &state->width, state->targetdin, &freqdin))
+    {
+        if (us_ticker_read() - state->start > AUTOTUNE_TIMEOUT)
+        {
+            printf("Freq16 not OK %d %d %d\n\r", state->targetdin, state->offset, state->tritone);
+            Finish(state, printit);
+        }
+        return;
+    }
+    m_measurements++;
+    state->offset += state->targetdin - freqdin;
+    state->offsets[state->cnt++] = state->offset;
+    if ((state->cnt > 1 && state->offsets[state->cnt - 2] == state->offset) || state->cnt == AUTOTUNE_TRIES)
+        Finish(state, printit);
+    else
+        state->phase = TuneOutput;
+}
+
+uint32_t Autotune::Run(bool printit, bool fit)
+{
+    Timer timer;
+    int8_t active;
+    TuneState *state;
+    timer.start();
+    m_running = true, m_runs++; // Retune leaves the VCOs alone and starts its passes again
+    m_count = 0, m_cycles = 0, m_measurements = 0;
+    for (int i = 0; i < NUMBERVCOS; i++)
+    {
+        if (!VCOS[i])
+            continue;
+        state = &m_states[m_count++];
+        state->vco = VCOS[i];
+        state->vco->Tunebegin();
+        state->offset = 0;
+        state->fit = fit, state->measured = 0, state->tried = 0, state->points = 0, state->predicting = false;
+        Start(state, TUNE_FIRST);
+    }
+    do
+    {
+        DACBusHold(); // every VCO's next test voltage goes out in one burst per bus
+        for (int i = 0; i < m_count; i++)
+        {
+            state = &m_states[i];
+            if (state->phase != TuneOutput)
+                continue;
+            if (!state->vco->Getdac()->DinOK(state->targetdin, state->offset))
+            {
+                printf("DinOK not OK %d %d\n\r", state->targetdin, state->offset);
+                Finish(state, printit);
+                continue;
+            }
+            state->vco->Getdac()->Voutprim(state->targetdin + state->offset);
+            state->vco->GetFreqChannel()->Clearring();
+            state->samples = state->vco->GetFreqChannel()->Getsamples();
+            state->width = 0;
+            state->start = us_ticker_read();
+            state->phase = TuneSettle;
+        }
+        DACBusFlush();
+        Thread::wait(1);
+        active = 0;
+        for (int i = 0; i < m_count; i++)
+        {
+            state = &m_states[i];
+            if (state->phase == TuneSettle)
+                Harvest(state, printit);
+            if (state->phase != TuneDone)
+                active++;
+        }
+        m_cycles++;
+    } while (active);
+    for (int i = 0; i < m_count; i++)
+        m_states[i].vco->Tuneend(printit);
+    m_running = false;
+    m_ms = timer.read_ms();
+    return (m_ms);
+}
+
+bool Autotune::Running(void)
+{
+    return (m_running);
+}
+
+uint32_t Autotune::Getruns(void)
+{
+    return (m_runs);
+}
+
+char *Autotune::print(void)
+{
+    sprintf(m_buffer, "Autotune %d VCOs %s%lu ms cycles %lu measurements %lu\r\n",
+            m_count,
+            m_count && m_states[0].fit ? "fit " : "",
+            (long unsigned int)m_ms,
+            (long unsigned int)m_cycles,
+            (long unsigned int)m_measurements);
+    return m_buffer;
+}
+
+Retune::Retune(Autotune *autotune)
+{
+    m_autotune = autotune;
+    m_enabled = false; // Idle only knows the MIDI gates and VCAs, menu 'h' turns it on when playing by MIDI
+    m_passes = 0, m_aborts = 0, m_measurements = 0;
+    for (int i = 0; i < NUMBERVCOS; i++)
+        m_states[i].phase = RetuneRest, m_states[i].start = 0;
+}
+
+void Retune::Begin(VCO *vco, RetuneState *state)
+{ // the pass starts from the offsets in use
+    int8_t tritones = vco->Gettritones();
+    tritones = tritones > AUTOTUNE_TRITONES ? AUTOTUNE_TRITONES : tritones;
+    for (int8_t tritone = 0; tritone < tritones; tritone++)
+        state->offsets[tritone] = vco->Getoffset(tritone);
+    state->runs = m_autotune->Getruns();
+    Start(vco, state, TUNE_FIRST);
+}
+
+void Retune::Start(VCO *vco, RetuneState *state, int8_t tritone)
+{
+    OctaveXstep ox = vco->Tritone(tritone);
+    state->tritone = tritone;
+    state->targetdin = vco->Dinx(ox.octave, ox.xstep);
+    state->offset = state->offsets[tritone];
+    state->cnt = 0;
+    state->phase = RetuneWait;
+}
+
+bool Retune::Claim(VCO *vco, RetuneState *state, int32_t din)
+{ // the MIDI and envelope interrupts cannot come between the check and the output
+    LTC2668 *dac = vco->Getdac();
+    bool claimed;
+    dac->GetBus()->Hold(); // the code is only staged, so nothing waits for the bus with interrupts off
+    core_util_critical_section_enter();
+    claimed = vco->Idle() && dac->Getvouts() == state->vouts;
+    if (claimed)
+    {
+        vco->Setretuning(true);
+        dac->Voutprim(din);
+        vco->GetFreqChannel()->Clearring();
+    }
+    core_util_critical_section_exit();
+    dac->GetBus()->Flush();
+    return (claimed);
+}
+
+void Retune::Output(VCO *vco, RetuneState *state)
+{
+    if (!vco->Idle())
+    { // a note has the output, VCOAdj0 corrects it
+        vco->Setretuning(false);
+        return;
+    }
+    if (!vco->Getdac()->DinOK(state->targetdin, state->offset))
+    {
+        Next(vco, state); // the old offset is kept
+        return;
+    }
+    state->vouts = vco->Getdac()->Getvouts();
+    if (!Claim(vco, state, state->targetdin + state->offset))
+        return;
+    state->samples = vco->GetFreqChannel()->Getsamples();
+    state->width = 0;
+    state->start = us_ticker_read();
+    state->phase = RetuneSettle;
+}
+
+void Retune::Harvest(VCO *vco, RetuneState *state)
+{ // the settle rule and timeout of Autotune::Harvest, but the voice may be taken back at any time
+    int32_t freqdin, total = 0;
+    if (!vco->Idle() || vco->Getdac()->Getvouts() != state->vouts)
+    { // played, the note has the output now and the tritone is measured again later
+        m_aborts++;
+        vco->Setretuning(false);
+        state->offset = state->offsets[state->tritone], state->cnt = 0;
+        state->phase = RetuneWait;
+        return;
+    }
+    if (!Settled(vco, &state->samples, &state->width, state->targetdin, &freqdin))
+    {
+        if (us_ticker_read() - state->start > AUTOTUNE_TIMEOUT)
+            Next(vco, state);
+        return;
+    }
+    m_measurements++;
+    state->offset += state->targetdin - freqdin;
+    state->tries[state->cnt++] = state->offset;
+    if (state->cnt > 1 && state->tries[state->cnt - 2] == state->offset)
+    {
+        state->offsets[state->tritone] = state->offset;
+        Next(vco, state);
+    }
+    else if (state->cnt == AUTOTUNE_TRIES)
+    {
+        for (int8_t i = 0; i < state->cnt; i++)
+            total += state->tries[i];
+        state->offsets[state->tritone] = (total + state->cnt / 2) / state->cnt;
+        Next(vco, state);
+    }
+    else if (Claim(vco, state, state->targetdin + state->offset))
+    {
+        state->width = 0;
+        state->start = us_ticker_read();
+    }
+}
+
+void Retune::Next(VCO *vco, RetuneState *state)
+{ // the test voltage stays out for the next tritone, a note takes the output back anyway and VCOAdj0
+    // corrects the note until the next tritone claims the output
+    if (state->tritone >= TUNE_LAST)
+        Swap(vco, state);
+    else
+    {
+        vco->Setretuning(false);
+        Start(vco, state, state->tritone + 1);
+    }
+}
+
+void Retune::Swap(VCO *vco, RetuneState *state)
+{ // the tritones outside the tuned range move with the nearest tuned one, then the new offsets go in
+    LTC2668 *dac = vco->Getdac();
+    int8_t tritones = vco->Gettritones();
+    int16_t low = state->offsets[TUNE_FIRST] - vco->Getoffset(TUNE_FIRST);
+    int16_t high = state->offsets[TUNE_LAST] - vco->Getoffset(TUNE_LAST);
+    tritones = tritones > AUTOTUNE_TRITONES ? AUTOTUNE_TRITONES : tritones;
+    for (int8_t tritone = 0; tritone < TUNE_FIRST; tritone++)
+        state->offsets[tritone] += low;
+    for (int8_t tritone = TUNE_LAST + 1; tritone < tritones; tritone++)
+        state->offsets[tritone] += high;
+    vco->Setoffsets(state->offsets, tritones);
+    dac->GetBus()->Hold();
+    core_util_critical_section_enter();
+    if (vco->Getretuning() && dac->Getvouts() == state->vouts)
+        dac->Voutprim(dac->Getdin()); // back to the last note, the next note uses the new offsets
+    vco->Setretuning(false);
+    core_util_critical_section_exit();
+    dac->GetBus()->Flush();
+    m_passes++;
+    state->start = us_ticker_read();
+    state->phase = RetuneRest;
+}
+
+void Retune::Run(void)
+{ // one cycle a millisecond, the voices are tuned independently of each other
+    VCO *vco;
+    RetuneState *state;
+    while (true)
+    {
+        Thread::wait(1);
+        if (!m_enabled || m_autotune->Running())
+            continue;
+        for (int i = 0; i < NUMBERVCOS; i++)
+        {
+            vco = VCOS[i], state = &m_states[i];
+            if (!vco || !vco->Gettuned())
+                continue;
+            if (state->phase != RetuneRest && state->runs != m_autotune->Getruns())
+            { // Autotune replaced the offsets this pass started from
+                vco->Setretuning(false);
+                Begin(vco, state);
+            }
+            switch (state->phase)
+            {
+            case RetuneRest:
+                if (us_ticker_read() - state->start >= RETUNE_PERIOD)
+                    Begin(vco, state);
+                break;
+            case RetuneWait:
+                Output(vco, state);
+                break;
+            case RetuneSettle:
+                Harvest(vco, state);
+                break;
+            }
+        }
+    }
+}
+
+void Retune::Enable(bool enabled)
+{
+    m_enabled = enabled;
+}
+
+bool Retune::Getenabled(void)
+{
+    return (m_enabled);
+}
+
+char *Retune::print(void)
+{
+    sprintf(m_buffer, "Retune %s passes %lu aborts %lu measurements %lu\r\n",
+            m_enabled ? "on" : "off",
+            (long unsigned int)m_passes,
+            (long unsigned int)m_aborts,
+            (long unsigned int)m_measurements);
+    return m_buffer;
+}
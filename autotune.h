@@ -0,0 +1,120 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include "mbed.h"
+#include "vco.h"
+
+#define AUTOTUNE_TRIES 8         // measurements of one tritone before the offsets are averaged
+#define AUTOTUNE_SETTLE 10       // settled when two widths differ by less than width >> AUTOTUNE_SETTLE
+#define AUTOTUNE_TIMEOUT 500000  // microseconds without a settled width before a tritone is given up
+#define AUTOTUNE_OUTLIER 3000    // dins, a measurement further than this from the target is ignored
+#define AUTOTUNE_TRITONES 32     // bits of TuneState::measured, more than any VCO's tritones
+#define AUTOTUNE_FITMIN 5        // tritones measured before the model may be accepted
+#define AUTOTUNE_FITTOL 11       // dins (2 cents), the model is accepted when it predicted the newest offset this well
+#define AUTOTUNE_FITCENTER 11    // tritone of the model's scale term origin, halfway through the tuned range
+#define RETUNE_PERIOD 60000000   // microseconds from the end of a VCO's background retune to the next
+
+enum TunePhase
+{
+    TuneOutput, // the DAC needs the next test voltage
+    TuneSettle, // waiting for the VCO's frequency to stop changing
+    TuneDone
+};
+
+struct TuneState
+{
+    VCO *vco;
+    TunePhase phase;
+    int8_t tritone, cnt;
+    int32_t targetdin, offset;
+    int16_t offsets[AUTOTUNE_TRIES];
+    uint32_t samples, width, start; // FreqChannel sample count and width, us_ticker time of the output
+    // model fit mode
+    bool fit;
+    uint32_t measured, tried;                   // bit per tritone, tried includes the ones which failed
+    int8_t points;                              // tritones measured
+    int16_t measuredoffsets[AUTOTUNE_TRITONES]; // offset of each measured tritone
+    int32_t predicted;                          // the model's offset for the tritone being measured
+    bool predicting;                            // the model existed when the tritone was started
+    double model[3];                            // offset, scale and rolloff terms in dins
+};
+
+class Autotune // Tunes every VCO at the same time.  Each cycle sends the next test voltage of every VCO in
+// one DAC burst, then takes whichever FreqChannel widths have arrived.  A tritone's measurement is used
+// once two widths in a row agree, and the tritone is finished when the offset stops changing.  Each
+// tritone starts from the offset of the one below it, so most take two or three measurements.
+// In fit mode only a few tritones are measured, the widest gap first, and a least squares fit of the
+// exponential converter's offset, scale and high frequency rolloff fills the rest of the offset table.
+// Tuning stops once the fit predicted the newest measured tritone within AUTOTUNE_FITTOL.
+{
+  private:
+    TuneState m_states[NUMBERVCOS];
+    int8_t m_count;
+    volatile bool m_running;
+    volatile uint32_t m_runs;
+    uint32_t m_cycles, m_measurements, m_ms;
+    char m_buffer[120]; // print's counters at full width
+    void Start(TuneState *state, int8_t tritone);
+    void Finish(TuneState *state, bool printit);
+    void Harvest(TuneState *state, bool printit);
+    void Next(TuneState *state, bool printit);
+    int8_t Nexttritone(TuneState *state);
+    bool Fit(TuneState *state);
+    int32_t Predict(TuneState *state, int8_t tritone);
+    void Fill(TuneState *state, bool printit);
+
+  public:
+    Autotune(void);
+    uint32_t Run(bool printit, bool fit = false); // tune all VCOs, returns the milliseconds it took
+    bool Running(void);
+    uint32_t Getruns(void);
+    char *print(void);
+};
+
+enum RetunePhase
+{
+    RetuneRest,   // RETUNE_PERIOD since the last pass
+    RetuneWait,   // waiting for the voice to be idle
+    RetuneSettle, // the test voltage is out, waiting for the VCO's frequency to stop changing
+};
+
+struct RetuneState
+{
+    RetunePhase phase;
+    int8_t tritone, cnt;
+    int32_t targetdin, offset;
+    int16_t tries[AUTOTUNE_TRIES];
+    int16_t offsets[AUTOTUNE_TRITONES]; // the new calibration, swapped in once every tritone is measured
+    int16_t vouts;                      // LTC2668 Vout count when the voice was claimed
+    uint32_t samples, width, start;     // FreqChannel sample count and width, us_ticker time of the output
+    uint32_t runs;                      // Autotune runs when the pass began
+};
+
+class Retune // Retunes the VCOs in the background while the instrument is played.  A voice is only
+// measured while it is idle, and a Vout by anything else (a note, an envelope) takes it back at once.
+// The measured offsets are kept aside and replace the VCO's offsets in one step when the pass is
+// complete, so the old calibration is used until then.
+{
+  private:
+    Autotune *m_autotune;
+    RetuneState m_states[NUMBERVCOS];
+    volatile bool m_enabled;
+    uint32_t m_passes, m_aborts, m_measurements;
+    char m_buffer[80];
+    void Begin(VCO *vco, RetuneState *state);
+    void Start(VCO *vco, RetuneState *state, int8_t tritone);
+    void Output(VCO *vco, RetuneState *state);
+    void Harvest(VCO *vco, RetuneState *state);
+    void Next(VCO *vco, RetuneState *state);
+    void Swap(VCO *vco, RetuneState *state);
+    bool Claim(VCO *vco, RetuneState *state, int32_t din); // output din if the voice is still idle and not played
+
+  public:
+    Retune(Autotune *autotune);
+    void Run(void); // the retune thread
+    void Enable(bool enabled);
+    bool Getenabled(void);
+    char *print(void);
+};
+
+#endif
@@ -0,0 +1,145 @@
+// board.cpp ... The NDAC6416 board description and the statically placed DAC, ADC and frequency
+// channel objects.
+#include "mbed.h"
+#include "board.h"
+
+// for these to work  copytargetchanges has modified .\mbed-os\targets\TARGET_STM\TARGET_STM32F7\TARGET_STM32F767xI\TARGET_NUCLEO_F767ZI\PeripheralPins.c:
+
+SPI spi1(PD_7, PG_9, PG_11); //SPI(MOSI, MISO, SCLK); -> DAC32-47 ok
+DigitalOut spi1_nss(PG_10);
+
+SPI spi2(PB_15, PB_14, PB_13); //SPI(MOSI, MISO, SCLK); -> ADC0-7 ok
+DigitalOut spi2_nss(PB_9);
+
+SPI spi3(PC_12, PC_11, PC_10); //SPI(MOSI, MISO, SCLK); -> ADC8-15 ok
+DigitalOut spi3_nss(PA_4);
+
+SPI spi4(PE_6, PE_5, PE_2); //SPI(MOSI, MISO, SCLK); -> DAC16-31 ok
+DigitalOut spi4_nss(PE_4);
+
+SPI spi5(PF_9, PF_8, PF_7); //SPI(MOSI, MISO, SCLK); -> DAC0-15 ok
+DigitalOut spi5_nss(PF_6);
+
+SPI spi6(PG_14, PG_12, PG_13, PG_8); //SPI(MOSI, MISO, SCLK); -> DAC48-63 ok
+DigitalOut spi6_nss(PG_8);
+
+DACBus b0(0, &spi5, &spi5_nss);
+DACBus b1(1, &spi4, &spi4_nss);
+DACBus b2(2, &spi1, &spi1_nss);
+DACBus b3(3, &spi6, &spi6_nss);
+
+DigitalIn adc0_nbusy(PG_0, PullUp);
+DigitalIn adc1_nbusy(PG_1, PullUp);
+
+#define DACTSHIFT 9 // adjustment threshold is the target width >> DACTSHIFT
+
+#define SPAN5 {-5, 5}
+#define DACCHIP(bus)                                                                         \
+    {bus, 0, SPAN5}, {bus, 1, SPAN5}, {bus, 2, SPAN5}, {bus, 3, SPAN5},                      \
+    {bus, 4, SPAN5}, {bus, 5, SPAN5}, {bus, 6, SPAN5}, {bus, 7, SPAN5},                      \
+    {bus, 8, SPAN5}, {bus, 9, SPAN5}, {bus, 10, SPAN5}, {bus, 11, SPAN5},                    \
+    {bus, 12, SPAN5}, {bus, 13, SPAN5}, {bus, 14, SPAN5}, {bus, 15, SPAN5}
+#define ADCCHIP(bus)                                                                         \
+    {bus, 0, SPAN5}, {bus, 1, SPAN5}, {bus, 2, SPAN5}, {bus, 3, SPAN5},                      \
+    {bus, 4, SPAN5}, {bus, 5, SPAN5}, {bus, 6, SPAN5}, {bus, 7, SPAN5}
+
+const DACDesc DACBOARD[NUMBERDACS] = {DACCHIP(0), DACCHIP(1), DACCHIP(2), DACCHIP(3)};
+
+const ADCDesc ADCBOARD[NUMBERADCS] = {ADCCHIP(0), ADCCHIP(1)};
+
+const FreqDesc FREQBOARD[NUMBERFREQS] = {
+    // DMA1 requests: TIM2_CHx are on channel 3 and TIM5_CHx on channel 6, every stream is used once
+    {0, GPIOA, RCC_AHB1ENR_GPIOAEN, 15, &TIM2->CCR1, 1, DMA1_Stream5, 3},
+    {0, GPIOB, RCC_AHB1ENR_GPIOBEN, 3, &TIM2->CCR2, 1, DMA1_Stream6, 3},
+    {0, GPIOB, RCC_AHB1ENR_GPIOBEN, 10, &TIM2->CCR3, 1, DMA1_Stream1, 3},
+    {0, GPIOB, RCC_AHB1ENR_GPIOBEN, 11, &TIM2->CCR4, 1, DMA1_Stream7, 3},
+    {1, GPIOA, RCC_AHB1ENR_GPIOAEN, 0, &TIM5->CCR1, 2, DMA1_Stream2, 6},
+    {1, GPIOA, RCC_AHB1ENR_GPIOAEN, 1, &TIM5->CCR2, 2, DMA1_Stream4, 6},
+    {1, GPIOA, RCC_AHB1ENR_GPIOAEN, 2, &TIM5->CCR3, 2, DMA1_Stream0, 6},
+    {1, GPIOA, RCC_AHB1ENR_GPIOAEN, 3, &TIM5->CCR4, 2, DMA1_Stream3, 6},
+};
+
+#if NUMBERVCOS > NUMBERFREQS
+#error "every VCO needs its own frequency channel"
+#endif
+
+// 10 octaves from 13.75 Hz at -5 volts, 1 volt per octave on a +-5 volt span
+#define VOICE(freq, dac, vca) {freq, dac, vca, 13.75, -5.0, 10, 6528, 1, &VCOAdj0}
+
+const VoiceDesc VOICEBOARD[NUMBERVCOS] = {
+    // DACs 6-12 are the VCA and VCF controls, so the last two voices are on bus 1 (spi4)
+    VOICE(0, 0, 6), VOICE(1, 1, 10), VOICE(2, 2, -1), VOICE(3, 3, -1),
+    VOICE(4, 4, -1), VOICE(5, 5, -1), VOICE(6, 16, -1), VOICE(7, 17, -1),
+};
+
+LTC2668 dacs[NUMBERDACS];
+LTC1859 adcs[NUMBERADCS];
+FreqChannel freqchannels[NUMBERFREQS];
+VCO vcos[NUMBERVCOS];
+
+void SetupBoard(void)
+{
+    int i;
+    for (i = 0; i < NUMBERDACS; i++)
+        dacs[i].Init((DACBOARD[i].bus << 4) | DACBOARD[i].channel, DACBUSES[DACBOARD[i].bus], NULL, false, DACTSHIFT);
+    for (i = 0; i < NUMBERADCS; i++)
+    {
+        if (ADCBOARD[i].bus)
+            adcs[i].Init((ADCBOARD[i].bus << 3) | ADCBOARD[i].channel, &spi3, &spi3_nss, &adc1_nbusy, ADCBOARD[i].span);
+        else
+            adcs[i].Init(ADCBOARD[i].channel, &spi2, &spi2_nss, &adc0_nbusy, ADCBOARD[i].span);
+    }
+    for (i = 0; i < NUMBERFREQS; i++)
+    {
+        freqchannels[i].Init(FREQBOARD[i].gpio, FREQBOARD[i].timer ? freqtimer1 : freqtimer0,
+                             FREQBOARD[i].enable, FREQBOARD[i].port, i, FREQBOARD[i].ccr, FREQBOARD[i].af);
+        freqchannels[i].Setdma(FREQBOARD[i].dma, FREQBOARD[i].dmachannel);
+    }
+}
+
+void SetupVoices(void)
+{ // each VCO starts its adjustment thread
+    for (int i = 0; i < NUMBERVCOS; i++)
+    {
+        vcos[i].Init(&freqchannels[VOICEBOARD[i].freq], &dacs[VOICEBOARD[i].dac], i,
+                     VOICEBOARD[i].lowfreq, VOICEBOARD[i].lowvolts, VOICEBOARD[i].octaves,
+                     VOICEBOARD[i].dins_per_volt, VOICEBOARD[i].octaves_per_volt, VOICEBOARD[i].adjfunc);
+        vcos[i].Setvca(VOICEBOARD[i].vca < 0 ? NULL : &dacs[VOICEBOARD[i].vca]);
+    }
+}
+
+bool FreqVoiced(int8_t freq)
+{
+    for (int i = 0; i < NUMBERVCOS; i++)
+        if (VOICEBOARD[i].freq == freq)
+            return (true);
+    return (false);
+}
+
+void SetupSPIs(void)
+{
+    // DAC32-47
+    spi1_nss = 1;
+    spi1.format(8, 0);
+    spi1.frequency(5000000);
+    // ADC0-7
+    spi2_nss = 1;
+    spi2.format(8, 0);
+    spi2.frequency(5000000);
+    // ADC8-15
+    spi3_nss = 1;
+    spi3.format(8, 0);
+    spi3.frequency(5000000);
+    // DAC16-31
+    spi4_nss = 1;
+    spi4.format(8, 0);
+    spi4.frequency(5000000);
+    // DAC0-15
+    spi5_nss = 1;
+    spi5.format(8, 0);
+    spi5.frequency(5000000);
+    // DAC48-63
+    spi6_nss = 1;
+    spi6.format(8, 0);
+    spi6.frequency(5000000);
+}
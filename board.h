@@ -0,0 +1,66 @@
+// board.h ... Topology of the NDAC6416 board.  Every DAC, ADC and frequency channel is described
+// by a const table (placed in flash) and the objects are statically placed arrays bound to the
+// tables by SetupBoard and SetupVoices, so nothing is allocated at startup.
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "mbed.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "dacbus.h"
+#include "adc.h"
+
+struct DACDesc
+{
+    int8_t bus;     // DACBus (spi5, spi4, spi1, spi6), each bus has its own chip select
+    int8_t channel; // DAC on the LTC2668
+    voltspan span;
+};
+
+struct ADCDesc
+{
+    int8_t bus;     // 0 is spi2, 1 is spi3
+    int8_t channel; // ADC on the LTC1859
+    voltspan span;
+};
+
+struct FreqDesc
+{
+    int8_t timer; // 0 is TIM2, 1 is TIM5
+    typeof(GPIOA) gpio;
+    uint32_t enable;
+    uint8_t port;
+    volatile uint32_t *ccr;
+    uint32_t af;
+    DMA_Stream_TypeDef *dma; // DMA1 stream for the channel's capture requests
+    uint8_t dmachannel;
+};
+
+struct VoiceDesc
+{
+    int8_t freq; // FreqChannel measuring the VCO
+    int8_t dac;  // LTC2668 driving the VCO's pitch
+    int8_t vca;  // LTC2668 playing the voice's VCA envelope, -1 when there is none
+    float lowfreq, lowvolts;
+    int8_t octaves;
+    int16_t dins_per_volt, octaves_per_volt;
+    vcoadjtype adjfunc; // the VCO's adjustment thread
+};
+
+extern const DACDesc DACBOARD[NUMBERDACS];
+extern const ADCDesc ADCBOARD[NUMBERADCS];
+extern const FreqDesc FREQBOARD[NUMBERFREQS];
+extern const VoiceDesc VOICEBOARD[NUMBERVCOS];
+
+extern LTC2668 dacs[NUMBERDACS];
+extern LTC1859 adcs[NUMBERADCS];
+extern FreqChannel freqchannels[NUMBERFREQS];
+extern VCO vcos[NUMBERVCOS];
+
+void SetupBoard(void);        // bind the objects to the board tables, first thing in main
+void SetupVoices(void);       // bind the VCOs to their channels and DACs once the DAC spans are set
+bool FreqVoiced(int8_t freq); // a VCO is measured by the frequency channel
+void SetupSPIs(void);
+
+#endif
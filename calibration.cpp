@@ -0,0 +1,149 @@
+// calibration.cpp ... Calibration class which keeps the VCO tuning offsets in the internal flash
+#include "mbed.h"
+#include <stddef.h>
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "calibration.h"
+
+Calibration::Calibration(void)
+{
+    m_address = 0, m_size = 0;
+    m_loaded = 0, m_failed = 0;
+    memset(m_records, 0, sizeof(m_records));
+}
+
+uint32_t Calibration::Checksum(const CalRecord *record)
+{ // bitwise CRC-32, the records are only checked at boot
+    const uint8_t *p = (const uint8_t *)record;
+    uint32_t crc = 0xffffffff;
+    for (uint32_t i = 0; i < offsetof(CalRecord, checksum); i++)
+    {
+        crc ^= p[i];
+        for (int8_t bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+    }
+    return (~crc);
+}
+
+bool Calibration::Open(void)
+{ // the records live in the sector after the image, their size is rounded up to the page size
+    uint32_t page, end;
+    if (m_address)
+        return (true);
+    if (m_flash.init())
+        return (false);
+    end = m_flash.get_flash_start() + m_flash.get_flash_size();
+    m_address = m_flash.get_flash_start() + CAL_APPSIZE;
+    if (m_address >= end || m_address + m_flash.get_sector_size(m_address) > end)
+    {
+        printf("Calibration sector %08lx is not in the flash\n\r", (long unsigned int)m_address);
+        m_address = 0;
+        return (false);
+    }
+    page = m_flash.get_page_size();
+    m_size = ((sizeof(m_records) + page - 1) / page) * page;
+    if (m_size > CAL_BLOCKSIZE)
+    {
+        printf("Calibration records %lu bytes do not fit %d\n\r", (long unsigned int)m_size, CAL_BLOCKSIZE);
+        m_address = 0;
+        return (false);
+    }
+    return (true);
+}
+
+int8_t Calibration::Load(void)
+{
+    CalRecord *record;
+    VCO *vco;
+    m_loaded = 0, m_failed = 0;
+    if (!Open() || m_flash.read(m_block, m_address, m_size))
+        return (0);
+    memcpy(m_records, m_block, sizeof(m_records));
+    for (int i = 0; i < NUMBERVCOS; i++)
+    {
+        record = &m_records[i];
+        vco = VCOS[i];
+        if (!vco || record->magic != CAL_MAGIC)
+            continue;
+        if (record->version != CAL_VERSION || record->vconum != i ||
+            record->tritones != vco->Gettritones() || record->checksum != Checksum(record))
+        { // erased, from an older version or corrupted, the VCO stays untuned
+            m_failed++;
+            continue;
+        }
+        vco->Tunebegin();
+        for (int8_t tritone = 0; tritone < record->tritones; tritone++)
+            vco->Setoffset(tritone, record->offsets[tritone]);
+        vco->Tuneend(false);
+        m_loaded++;
+    }
+    return (m_loaded);
+}
+
+bool Calibration::Save(void)
+{
+    CalRecord *record;
+    VCO *vco;
+    if (!Open())
+        return (false);
+    for (int i = 0; i < NUMBERVCOS; i++)
+    {
+        record = &m_records[i];
+        vco = VCOS[i];
+        if (!vco || !vco->Gettuned() || vco->Gettritones() > CAL_OFFSETS)
+            continue; // keep what was loaded for a VCO which is not tuned now
+        memset(record, 0, sizeof(CalRecord));
+        record->magic = CAL_MAGIC;
+        record->version = CAL_VERSION;
+        record->vconum = i;
+        record->tritones = vco->Gettritones();
+        record->tuned = (uint32_t)time(NULL);
+        for (int8_t tritone = 0; tritone < record->tritones; tritone++)
+            record->offsets[tritone] = vco->Getoffset(tritone);
+        record->checksum = Checksum(record);
+    }
+    memset(m_block, 0xff, m_size);
+    memcpy(m_block, m_records, sizeof(m_records));
+    if (m_flash.erase(m_address, m_flash.get_sector_size(m_address)))
+        return (false);
+    return (m_flash.program(m_block, m_address, m_size) == 0);
+}
+
+bool Calibration::Check(VCO *vco)
+{ // spot-check a low, middle and high tritone, the output is restored afterwards.  The voice is
+    // claimed as Retune::Claim does, so VCOAdj0 does not drive the DAC back to the note meanwhile
+    const int8_t tritones[] = {TUNE_FIRST + 2, (TUNE_FIRST + TUNE_LAST) / 2, TUNE_LAST - 2};
+    LTC2668 *dac = vco->Getdac();
+    int16_t vout = dac->GetVOUT();
+    int32_t targetdin, freqdin, offset;
+    uint32_t freq16;
+    bool ok = true;
+    vco->Setretuning(true);
+    for (uint8_t i = 0; ok && i < sizeof(tritones); i++)
+    {
+        OctaveXstep ox = vco->Tritone(tritones[i]);
+        targetdin = vco->Dinx(ox.octave, ox.xstep);
+        offset = vco->Getoffset(tritones[i]);
+        dac->Voutprim(targetdin + offset);
+        wait(.02);                              // allow VCO to settle
+        vco->GetFreqChannel()->Clearring();     // the median of the periods since it settled
+        vco->GetFreqChannel()->SampledFreq16(); // the first width may span the change
+        freq16 = vco->GetFreqChannel()->SampledFreq16();
+        freqdin = freq16 ? (int32_t)vco->Dinf(freq16) : 0;
+        ok = freq16 && abs(targetdin - freqdin) <= CAL_SPOTCHECK;
+    }
+    dac->Vout(vout, true);
+    vco->Setretuning(false);
+    return (ok);
+}
+
+char *Calibration::print(void)
+{
+    sprintf(m_buffer, "Calibration at %08lx %lu bytes loaded %d failed %d\r\n",
+            (long unsigned int)m_address,
+            (long unsigned int)m_size,
+            m_loaded,
+            m_failed);
+    return m_buffer;
+}
@@ -0,0 +1,53 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include "mbed.h"
+#include "vco.h"
+
+#define CAL_MAGIC 0x4e444143 // "NDAC"
+#define CAL_VERSION 1        // change when CalRecord changes, older records are ignored
+#define CAL_OFFSETS 24       // room for the tritones of 11 octaves
+#define CAL_BLOCKSIZE 1024   // bytes programmed, the records rounded up to the flash page size
+#define CAL_SPOTCHECK 20     // dins, a spot-checked tritone further off than this needs a retune
+#define CAL_APPSIZE 0x1c0000 // target.mbed_app_size in mbed_app.json, the last 256 KB sector is not linked
+
+#if defined(MBED_APP_SIZE) && MBED_APP_SIZE > CAL_APPSIZE
+#error "the image would overlap the calibration sector"
+#endif
+
+struct CalRecord
+{
+    uint32_t magic;
+    uint16_t version;
+    int8_t vconum;
+    int8_t tritones; // number of offsets used
+    uint32_t tuned;  // time() when the VCO was tuned, seconds since the RTC was set
+    int16_t offsets[CAL_OFFSETS];
+    uint32_t checksum; // CRC-32 of the fields above
+};
+
+class Calibration // Tritone offsets of every VCO kept in the last sector of the internal flash, which
+// the linker leaves out of the image.  Load at boot marks the VCOs with a good record tuned, Check
+// measures a few tritones to confirm it.  Save erases the sector, which stalls every instruction fetch
+// from the flash for about a second, so it is only called with the timers stopped.
+{
+  private:
+    FlashIAP m_flash;
+    CalRecord m_records[NUMBERVCOS];
+    uint8_t m_block[CAL_BLOCKSIZE];
+    uint32_t m_address, m_size;
+    int8_t m_loaded, m_failed;
+    char m_buffer[80];
+    uint32_t Checksum(const CalRecord *record);
+    bool Open(void);
+
+  public:
+    Calibration(void);
+    int8_t Load(void);    // returns the number of VCOs loaded and marked tuned
+    bool Save(void);      // save the offsets of every tuned VCO, the interrupts stall while it erases
+    bool Check(VCO *vco); // measure a few tuned tritones, false when the VCO has drifted, nothing else
+                          // may drive the VCO's DAC meanwhile
+    char *print(void);
+};
+
+#endif
@@ -0,0 +1,85 @@
+// curves.cpp ... CURVES, the shapes of the curved envelope segments, kept in flash
+// Generated once with double precision, x = i / CURVE_POINTS and k = 5:
+//     CurveExp   (exp(k * x) - 1) / (exp(k) - 1) * 65535
+//     CurveLog   (1 - exp(-k * x)) / (1 - exp(-k)) * 65535
+//     CurveS     (1 - cos(pi * x)) / 2 * 65535
+#include "mbed.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "envelope.h"
+
+const uint16_t CURVES[NUMBERCURVES - 1][CURVE_POINTS + 1] = {
+    { // CurveExp
+        0, 9, 18, 27, 36, 46, 55, 65, 75, 85, 96, 107,
+        117, 129, 140, 151, 163, 175, 187, 200, 212, 225, 239, 252,
+        266, 280, 294, 309, 324, 339, 354, 370, 386, 402, 419, 436,
+        453, 471, 489, 508, 526, 546, 565, 585, 605, 626, 647, 669,
+        691, 713, 736, 759, 783, 807, 832, 857, 883, 909, 936, 963,
+        991, 1019, 1048, 1077, 1107, 1138, 1169, 1201, 1233, 1266, 1300, 1334,
+        1370, 1405, 1442, 1479, 1517, 1556, 1595, 1635, 1676, 1718, 1761, 1804,
+        1849, 1894, 1940, 1987, 2035, 2084, 2134, 2185, 2237, 2289, 2343, 2398,
+        2454, 2512, 2570, 2629, 2690, 2752, 2815, 2879, 2945, 3011, 3080, 3149,
+        3220, 3292, 3366, 3441, 3518, 3596, 3676, 3757, 3840, 3924, 4010, 4098,
+        4188, 4279, 4372, 4467, 4564, 4663, 4764, 4867, 4971, 5078, 5187, 5298,
+        5411, 5527, 5645, 5765, 5887, 6012, 6140, 6269, 6402, 6537, 6675, 6815,
+        6958, 7104, 7253, 7405, 7560, 7718, 7879, 8043, 8210, 8381, 8555, 8732,
+        8913, 9098, 9286, 9478, 9674, 9873, 10077, 10284, 10496, 10712, 10932, 11156,
+        11385, 11618, 11856, 12099, 12346, 12598, 12856, 13118, 13386, 13658, 13936, 14220,
+        14509, 14804, 15105, 15412, 15724, 16043, 16369, 16700, 17038, 17383, 17735, 18093,
+        18459, 18832, 19212, 19600, 19995, 20398, 20809, 21228, 21656, 22092, 22536, 22989,
+        23452, 23923, 24404, 24894, 25393, 25903, 26423, 26953, 27493, 28044, 28606, 29179,
+        29763, 30359, 30966, 31586, 32218, 32862, 33519, 34189, 34872, 35568, 36279, 37003,
+        37741, 38495, 39263, 40046, 40844, 41659, 42489, 43336, 44199, 45080, 45978, 46893,
+        47827, 48779, 49750, 50740, 51750, 52779, 53829, 54899, 55991, 57104, 58239, 59396,
+        60577, 61780, 63007, 64259, 65535
+    },
+    { // CurveLog
+        0, 1276, 2528, 3755, 4958, 6139, 7296, 8431, 9544, 10636, 11706, 12756,
+        13785, 14795, 15785, 16756, 17708, 18642, 19557, 20455, 21336, 22199, 23046, 23876,
+        24691, 25489, 26272, 27040, 27794, 28532, 29256, 29967, 30663, 31346, 32016, 32673,
+        33317, 33949, 34569, 35176, 35772, 36356, 36929, 37491, 38042, 38582, 39112, 39632,
+        40142, 40641, 41131, 41612, 42083, 42546, 42999, 43443, 43879, 44307, 44726, 45137,
+        45540, 45935, 46323, 46703, 47076, 47442, 47800, 48152, 48497, 48835, 49166, 49492,
+        49811, 50123, 50430, 50731, 51026, 51315, 51599, 51877, 52149, 52417, 52679, 52937,
+        53189, 53436, 53679, 53917, 54150, 54379, 54603, 54823, 55039, 55251, 55458, 55662,
+        55861, 56057, 56249, 56437, 56622, 56803, 56980, 57154, 57325, 57492, 57656, 57817,
+        57975, 58130, 58282, 58431, 58577, 58720, 58860, 58998, 59133, 59266, 59395, 59523,
+        59648, 59770, 59890, 60008, 60124, 60237, 60348, 60457, 60564, 60668, 60771, 60872,
+        60971, 61068, 61163, 61256, 61347, 61437, 61525, 61611, 61695, 61778, 61859, 61939,
+        62017, 62094, 62169, 62243, 62315, 62386, 62455, 62524, 62590, 62656, 62720, 62783,
+        62845, 62906, 62965, 63023, 63081, 63137, 63192, 63246, 63298, 63350, 63401, 63451,
+        63500, 63548, 63595, 63641, 63686, 63731, 63774, 63817, 63859, 63900, 63940, 63979,
+        64018, 64056, 64093, 64130, 64165, 64201, 64235, 64269, 64302, 64334, 64366, 64397,
+        64428, 64458, 64487, 64516, 64544, 64572, 64599, 64626, 64652, 64678, 64703, 64728,
+        64752, 64776, 64799, 64822, 64844, 64866, 64888, 64909, 64930, 64950, 64970, 64989,
+        65009, 65027, 65046, 65064, 65082, 65099, 65116, 65133, 65149, 65165, 65181, 65196,
+        65211, 65226, 65241, 65255, 65269, 65283, 65296, 65310, 65323, 65335, 65348, 65360,
+        65372, 65384, 65395, 65406, 65418, 65428, 65439, 65450, 65460, 65470, 65480, 65489,
+        65499, 65508, 65517, 65526, 65535
+    },
+    { // CurveS
+        0, 2, 10, 22, 39, 62, 89, 121, 158, 200, 246, 298,
+        355, 416, 482, 554, 630, 710, 796, 887, 982, 1082, 1187, 1297,
+        1411, 1530, 1654, 1782, 1915, 2053, 2196, 2343, 2494, 2650, 2811, 2976,
+        3146, 3320, 3499, 3682, 3869, 4061, 4257, 4457, 4662, 4871, 5084, 5301,
+        5522, 5748, 5977, 6211, 6448, 6690, 6935, 7185, 7438, 7695, 7956, 8220,
+        8488, 8760, 9036, 9315, 9597, 9883, 10173, 10466, 10762, 11062, 11365, 11671,
+        11980, 12292, 12608, 12926, 13248, 13572, 13900, 14230, 14563, 14899, 15237, 15578,
+        15922, 16268, 16616, 16968, 17321, 17677, 18035, 18395, 18758, 19122, 19489, 19857,
+        20228, 20600, 20975, 21351, 21728, 22108, 22489, 22872, 23256, 23641, 24028, 24416,
+        24806, 25196, 25588, 25981, 26375, 26770, 27166, 27562, 27960, 28358, 28756, 29156,
+        29556, 29956, 30357, 30758, 31160, 31561, 31963, 32365, 32767, 33170, 33572, 33974,
+        34375, 34777, 35178, 35579, 35979, 36379, 36779, 37177, 37575, 37973, 38369, 38765,
+        39160, 39554, 39947, 40339, 40729, 41119, 41507, 41894, 42279, 42663, 43046, 43427,
+        43807, 44184, 44560, 44935, 45307, 45678, 46046, 46413, 46777, 47140, 47500, 47858,
+        48214, 48567, 48919, 49267, 49613, 49957, 50298, 50636, 50972, 51305, 51635, 51963,
+        52287, 52609, 52927, 53243, 53555, 53864, 54170, 54473, 54773, 55069, 55362, 55652,
+        55938, 56220, 56499, 56775, 57047, 57315, 57579, 57840, 58097, 58350, 58600, 58845,
+        59087, 59324, 59558, 59787, 60013, 60234, 60451, 60664, 60873, 61078, 61278, 61474,
+        61666, 61853, 62036, 62215, 62389, 62559, 62724, 62885, 63041, 63192, 63339, 63482,
+        63620, 63753, 63881, 64005, 64124, 64238, 64348, 64453, 64553, 64648, 64739, 64825,
+        64905, 64981, 65053, 65119, 65180, 65237, 65289, 65335, 65377, 65414, 65446, 65473,
+        65496, 65513, 65525, 65533, 65535
+    }
+};
@@ -3,18 +3,32 @@
 #include "freq.h"
 #include "vco.h"
 #include "dac.h"
+#include "dacbus.h"
+#include "waves.h"
 
-DACPtr *DACS = new DACPtr[NUMBERDACS]();
+DACPtr DACS[NUMBERDACS];
+
+LTC2668::LTC2668(void)
+{
+}
 
 LTC2668::LTC2668(int8_t dacnum,
-                 typeof(SPI) *spi,
-                 typeof(DigitalOut) *spinss,
+                 DACBus *bus,
                  VCO *vco,
                  bool printit,
                  int8_t tshift)
+{
+    Init(dacnum, bus, vco, printit, tshift);
+}
+
+void LTC2668::Init(int8_t dacnum,
+                   DACBus *bus,
+                   VCO *vco,
+                   bool printit,
+                   int8_t tshift)
 {
     m_dacnum = dacnum & 0x3f; // only 64 DACs
-    m_spi = spi, m_spinss = spinss, m_printit = printit;
+    m_bus = bus, m_printit = printit;
     m_vco = vco; // m_vco is NULL DAC is not connected to VCO
     if (m_vco != NULL)
     {
@@ -26,29 +40,50 @@ LTC2668::LTC2668(int8_t dacnum,
     m_csadrs = m_dacnum >> 4;
     m_tshift = tshift;
     m_vout = 0, m_cnt = 0, m_din = 0, m_voutdin = 0, m_voct_octave = 0, m_voct_halfstep = 0;
-    WidthFreq m_twidthfreq;
     m_twidthfreq.freq = 1;
     m_twidthfreq.freq16 = 16;
     m_twidthfreq.width = 0;
     m_dwidth = 0, m_width = 0, m_twidthshift = 0;
+    m_pibase = 0, m_piint = 0;
     DACS[m_dacnum] = this;
     Reset();
     m_adjust = true;
-    m_waveoffset = 0;
+    m_phase = 0;
+    m_rate = WAVERATE_ONE;
     m_wave = NULL;
+    m_stop = true;
 }
 
 NextState LTC2668::Next(bool printit)
-{
-    if (m_stop)
+{ // the point is interpolated between the two table points around m_phase, then m_phase advances by m_rate
+    const Wave *wave = m_wave; // Setwave may swap the wave between ticks
+    int32_t offset, marker, next;
+    uint16_t point;
+    if (m_stop || !wave)
+        return NextEnd;
+    offset = m_phase >> 16;
+    if (offset >= wave->end)
+    { // the end was reached or the wave was swapped for a shorter one
+        m_stop = true;
         return NextEnd;
-    m_point = m_wave[m_waveoffset];
+    }
+    m_point = wave->points[offset];
     if (printit)
         printf("N %x ", m_point);
     if (m_point > 1)
     { // 1 indicates end, and 0 indicates hold ... the point following hold is the beginning of the release segment
+        point = wave->points[offset + 1];
+        if (point > 1 && (m_phase & 0xffff)) // a 15 bit fraction keeps a full scale step within 32 bits
+            m_point += ((int32_t)(point - m_point) * (int32_t)((m_phase & 0xffff) >> 1)) >> 15;
         Vout((int32_t)m_point);
-        m_waveoffset++;
+        marker = offset < wave->hold ? wave->hold : wave->end;
+        next = (m_phase + m_rate) >> 16;
+        if (next >= marker && offset < marker - 1)
+            m_phase = (marker - 1) << 16; // never skip the last point before the hold or end
+        else if (next >= marker)
+            m_phase = marker << 16;
+        else
+            m_phase += m_rate;
         return NextPoint;
     }
     else
@@ -80,54 +115,53 @@ void LTC2668::Nexts(void)
     printf("\n\r");
 }
 
-void LTC2668::Start(bool printit)
+void LTC2668::Start(bool)
 {
-    m_waveoffset = 0;
+    m_phase = 0;
     m_stop = false;
     //return Next(printit);
 }
 
-void LTC2668::Release(bool printit)
+void LTC2668::Release(bool)
 {
-    m_waveoffset = m_holdoffset + 1;
+    const Wave *wave = m_wave;
+    if (wave)
+        m_phase = (wave->hold + 1) << 16;
     //return Next(printit);
 }
 
-void LTC2668::Setwave(const uint16_t *wave, int32_t wavenum)
-{
-    while (true)
-    {
-        m_offset = 0;
-        m_wave = (uint16_t *)wave;
-        while (true)
-        {
-            m_point = *wave++;
-            if (!m_point)
-                m_holdoffset = m_offset;
-            else if (m_point == 1)
-                break;
-            m_offset++;
-        }
-        if (!wavenum--)
-            break;
-    }
-    m_waveoffset = 0;
+void LTC2668::Setwave(const Wave *wave)
+{ // the hold and end offsets were found when the WaveBank was built, so this only swaps a pointer
     m_stop = true;
+    m_phase = 0;
+    m_wave = wave;
 }
 
-uint16_t *LTC2668::Getwave(void)
+void LTC2668::Setrate(uint32_t rate)
+{ // a rate above one point per tick still stops on the last point before the hold and the end
+    m_rate = rate ? rate : 1;
+}
+
+uint32_t LTC2668::Getrate(void)
+{
+    return m_rate;
+}
+
+const Wave *LTC2668::Getwave(void)
 {
     return m_wave;
 }
 
 void LTC2668::Dumpwave(void)
 {
-    uint16_t *wave = m_wave;
-    while (*wave != 1)
+    const Wave *wave = m_wave;
+    if (!wave)
+        return;
+    for (int16_t offset = 0; offset < wave->end; offset++)
     {
-        printf("%x ", *wave++);
+        printf("%x ", wave->points[offset]);
     }
-    printf(" hold offset %d\n\r", m_holdoffset);
+    printf(" hold offset %d\n\r", wave->hold);
 }
 
 void LTC2668::Clradjusted(void)
@@ -160,6 +194,21 @@ int16_t LTC2668::GetVOUT(void)
     return (m_vout);
 }
 
+int16_t LTC2668::Getvouts(void)
+{
+    return (m_cnt);
+}
+
+int32_t LTC2668::Getdin(void)
+{
+    return (m_din);
+}
+
+bool LTC2668::Sounding(void)
+{
+    return (!m_stop && m_wave);
+}
+
 void LTC2668::SetVCO(VCO *vco)
 {
     m_vco = vco;
@@ -170,6 +219,11 @@ VCO *LTC2668::GetVCO(void)
     return (m_vco);
 }
 
+DACBus *LTC2668::GetBus(void)
+{
+    return (m_bus);
+}
+
 bool LTC2668::DinOK(int32_t din, int16_t offset)
 {
     if (m_vco)
@@ -200,13 +254,7 @@ bool LTC2668::DinOKoffset(int32_t din)
 void LTC2668::Voutprim(int32_t din) // Send digital input value to the DAC
 {
     m_voutdin = din;
-    m_spinss->write(0);
-    m_send[0] = m_sendcode;
-    m_send[1] = din >> 8;
-    m_send[2] = din & 0xff;
-    //m_spi->transfer(m_send, 3, m_recv, 3, NULL);
-    m_spi->write(m_send, 3, m_recv, 3);
-    m_spinss->write(1);
+    m_bus->Code(m_sendcode, m_dacnum, din, m_recv); // not sent when the DAC already has the code
 }
 
 void LTC2668::Setspan(voltspan span)
@@ -229,7 +277,6 @@ void LTC2668::Setspan(voltspan span)
     {
         code = 3;
     }
-    m_spinss->write(0);
     m_send[0] = 0x60 | (m_dacnum & 0x0f); // command is write code to dac and update dac
     m_send[1] = 0;                        // don't care
     m_send[2] = code;
@@ -238,25 +285,21 @@ void LTC2668::Setspan(voltspan span)
            (uint8_t)m_send[0],
            (uint8_t)m_send[1],
            (uint8_t)m_send[2]);
-    //m_spi->transfer(m_send, 3, m_recv, 3, NULL);
-    m_spi->write(m_send, 3, m_recv, 3);
-    m_spinss->write(1);
+    m_bus->Send(m_send, m_recv);
 }
 
 void LTC2668::Voutall(int32_t din)
 { // Send digital input value to all DACs on chip
-    m_spinss->write(0);
-    m_send[0] = 0xa0;
-    m_send[1] = din >> 8;
-    m_send[2] = din & 0xff;
-    //m_spi->transfer(m_send, 3, m_recv, 3, NULL);
-    m_spi->write(m_send, 3, m_recv, 3);
-    m_spinss->write(1);
+    m_bus->Codeall(din, m_recv);
 }
 
 void LTC2668::Vchk(int32_t din) // Send digital input value to the DAC
 {
+    m_bus->Forget(m_dacnum); // always send so the received bytes are current
     Voutprim(din);
+    m_send[0] = m_sendcode;
+    m_send[1] = din >> 8;
+    m_send[2] = din & 0xff;
     printf("LTC2668 %02d: %04x (%02x %02x %02x -> %02x %02x %02x)\n\r",
            m_dacnum,
            (uint16_t)(din & 0xffff),
@@ -269,64 +312,60 @@ void LTC2668::Vchk(int32_t din) // Send digital input value to the DAC
 }
 
 void LTC2668::Adj(int32_t width, bool printit)
-{ // adjust din up or down 1 toward frequency
-    if (!m_vco->Gettuned() || !m_adjust)
+{ // PI control of din from the pitch error in cents, the integral is moved to the VCO's offsets once
+    // the error is within the deadband so the correction is kept for the next notes
+    int32_t error, correction, limit;
+    if (!m_vco->Gettuned() || !m_adjust || !width || !m_twidthfreq.width)
         return;
     m_width = width;
-    if (width > m_twidthfreq.width)
-    {
-        m_dwidth = width - m_twidthfreq.width;
-    }
-    else
-    {
-        m_dwidth = m_twidthfreq.width - width;
-    }
+    m_dwidth = width > m_twidthfreq.width ? width - m_twidthfreq.width : m_twidthfreq.width - width;
+    // a longer width is a lower frequency, 1/256 xsteps are 25/128 of 1/256 cents
+    error = ((Xlog2(width, 0) - Xlog2(m_twidthfreq.width, 0)) * 25) / 128;
+    m_offsetvals.error = error;
     if (printit)
     {
-        printf("%d. dwidth %s%-5d    width %6d twidth %6d posadj %-8d negadj %-8d shift %-4d din %5d %d\n\r",
+        printf("%d. dwidth %s%-5d    width %6d twidth %6d error %7.2f cents integral %d din %5d\n\r",
                m_dacnum,
                width > m_twidthfreq.width ? "+" : "-",
                m_dwidth,
-               //(float)FREQUENCY/(float)m_dwidth,
                width,
-               //(float)FREQUENCY/(float)width,
                m_twidthfreq.width,
-               m_offsetvals.posadj,
-               m_offsetvals.negadj,
-               m_twidthshift,
-               m_din,
-               m_dwidth < m_twidthshift);
+               (float)error / 256.0,
+               m_piint,
+               m_din);
     }
-    if (m_dwidth < m_twidthshift)
+    if (abs(error) <= PI_DEADBAND)
     {
+        correction = m_vco->Centstodins((m_piint * PI_KI) >> 8);
+        if (correction)
+        { // the din already includes the correction, now the offsets do too
+            m_vco->Addoffset(m_vout, correction);
+            m_pibase += correction;
+        }
+        m_piint = 0;
         m_offsetvals.adjusted = true;
         return;
     }
-    // m_offsetvals.dadj = m_dwidth>5?5:m_dwidth;
-    m_offsetvals.dadj = m_twidthshift >> 5;
-    if (width > m_twidthfreq.width)
+    m_offsetvals.steps++;
+    limit = (PI_WINDUP << 16) / PI_KI; // anti-windup
+    m_piint += error;
+    m_piint = m_piint > limit ? limit : m_piint < -limit ? -limit : m_piint;
+    correction = m_vco->Centstodins((error * PI_KP + m_piint * PI_KI) >> 8);
+    m_offsetvals.dadj = m_pibase + correction - m_din;
+    if (m_offsetvals.dadj > 0)
     {
         m_offsetvals.posadj += 1;
         m_offsetvals.pos += m_offsetvals.dadj;
-        m_din += m_offsetvals.dadj;
     }
     else
     {
         m_offsetvals.negadj += 1;
-        m_offsetvals.neg += m_offsetvals.dadj;
-        m_din -= m_offsetvals.dadj;
+        m_offsetvals.neg -= m_offsetvals.dadj;
     }
+    m_din = m_pibase + correction;
+    m_din = m_din < 0 ? 0 : m_din > 0xffff ? 0xffff : m_din;
     Voutprim(m_din);
-    if (printit)
-    {
-        printf("    dadj %d pos %d neg %d dadj %d din %d\n\r",
-               m_offsetvals.dadj,
-               m_offsetvals.pos,
-               m_offsetvals.neg,
-               m_offsetvals.dadj,
-               m_din);
-    }
-    //  m_vco->GetFreqChannel()->Stopadj();
+    m_vco->GetFreqChannel()->Clearring(); // the next error is measured from the new output only
 }
 
 void LTC2668::Wadj(bool printit)
@@ -344,13 +383,16 @@ void LTC2668::Vout(int32_t din, bool adjust)
     m_din = m_vout;
     if (m_vco && m_vco->Gettuned())
     {
-        if (DinOKoffset(din))
+        Pitch pitch = m_vco->Getpitch(m_vout); // no divides, Vout is called from the envelope ISRs
+        if (DinOK(din, pitch.offset))
         {
             m_din = m_offsetvals.newdin;
         }
-        m_twidthfreq = m_vco->Dintowidth(m_vout);
+        m_twidthfreq = pitch.widthfreq;
         m_twidthshift = m_twidthfreq.width >> m_tshift;
         m_offsetvals.reset(); // set adjusted to false
+        m_pibase = m_din, m_piint = 0;
+        m_vco->GetFreqChannel()->Clearring(); // Adj must not see the last note's periods
         //m_vco->GetFreqChannel()->Startadj();
     }
     Voutprim(m_din);
@@ -379,3 +421,33 @@ void LTC2668::Vmidi(int8_t midinumber, bool clr)
         Vout(m_vco->Dinh(m_voct_octave, m_voct_halfstep), false); // No Adjustments can occur here because Vmidi is called in ShowMessages
     }
 }
+
+void LTC2668::Begin(void)
+{
+    m_sendcode = 0x00 | (m_dacnum & 0x0f); // command is write code to dac
+}
+
+void LTC2668::End(void)
+{
+    m_sendcode = 0x30 | (m_dacnum & 0x0f); // command is write code to dac and update dac
+}
+
+void LTC2668::Commit(void)
+{
+    End();
+    m_bus->Updateall(); // command is update all dacs on the chip
+}
+
+void LTC2668::Settoggle(int32_t dina, int32_t dinb)
+{ // the chip's Toggle commands (or the TGP pin) then switch the DAC between the two codes
+    m_bus->Toggleselect(m_dacnum, false); // codes go to input register A
+    m_bus->Code(0x30, m_dacnum, dina);
+    m_bus->Toggleselect(m_dacnum, true); // codes go to input register B
+    m_bus->Code(0x30, m_dacnum, dinb);
+    m_voutdin = dina;
+}
+
+void LTC2668::Cleartoggle(void)
+{
+    m_bus->Toggleselect(m_dacnum, false); // the next code is always sent
+}
@@ -4,10 +4,20 @@
 #include "mbed.h"
 
 class VCO;
+class DACBus;
+struct Wave;
 
 #define NUMBERDACS 64
+#define WAVERATE_ONE 0x10000 // 16.16 fixed point wave rate, one table point per FuncTimer tick
+
+// PI pitch controller in Adj, errors are in 1/256 cents, PI_KP and PI_KI are 1/256 fractions of the
+// error and its integral and the correction is turned into dins by Centstodins
+#define PI_DEADBAND 256 // within 1 cent the VCO is adjusted and the integral goes to the offset table
+#define PI_KP 64
+#define PI_KI 128
+#define PI_WINDUP 100 // cents, limit of the integral's correction
 typedef LTC2668 *DACPtr;
-extern DACPtr *DACS;
+extern DACPtr DACS[NUMBERDACS];
 
 struct voltspan
 {
@@ -32,6 +42,8 @@ struct OffsetVals
     uint32_t neg;
     int16_t dadj;
     bool adjusted;
+    int32_t error;  // last pitch error in 1/256 cents
+    uint16_t steps; // Adj calls since Vout until the error was within the deadband
     void reset(void)
     {
         posadj = 0;
@@ -40,6 +52,8 @@ struct OffsetVals
         neg = 0;
         dadj = 0;
         adjusted = false;
+        error = 0;
+        steps = 0;
     }
 };
 
@@ -48,9 +62,7 @@ class LTC2668 // Linear Technologies 2668 16 channel 16-bit DAC chip with SPI in
 {
   private:
     VCO *m_vco;
-    typeof(SPI) *m_spi;
-    typeof(DigitalOut) *m_spinss;
-    //GPIO_TypeDef *m_spinss;
+    DACBus *m_bus;
     voltspan m_span;
     bool m_printit, m_adjust;
     int8_t m_tshift, m_sendcode, m_csadrs, m_voct_octave, m_voct_halfstep;
@@ -58,23 +70,30 @@ class LTC2668 // Linear Technologies 2668 16 channel 16-bit DAC chip with SPI in
     int16_t m_vout, m_cnt, m_tfreq;
     int32_t m_width, m_twidthshift, m_dwidth;
     int32_t m_din, m_voutdin;
+    int32_t m_pibase, m_piint; // din set by Vout and the PI controller's integral of the error
     OffsetVals m_offsetvals;
     WidthFreq m_twidthfreq;
-    uint16_t *m_wave;
+    const Wave *volatile m_wave; // from a WaveBank, swapped by Setwave while Next may be running
     uint16_t m_point;
     bool m_stop;
-    int32_t m_waveoffset, m_holdoffset, m_offset;
+    uint32_t m_phase; // 16.16 fixed point offset into the wave
+    uint32_t m_rate;  // added to m_phase every Next, WAVERATE_ONE plays the original speed
 
   public:
-    LTC2668(int8_t dacnum, typeof(SPI) *spi, typeof(DigitalOut) *spi_nss, VCO *vco, bool printit, int8_t tshift);
+    LTC2668(void); // for the statically placed board arrays, Init before use
+    LTC2668(int8_t dacnum, DACBus *bus, VCO *vco, bool printit, int8_t tshift);
+    void Init(int8_t dacnum, DACBus *bus, VCO *vco, bool printit, int8_t tshift);
     NextState Next(bool printit = false);
     void Start(bool printit = false);
     void Release(bool printit = false);
     void Nexts(void);
-    void Setwave(const uint16_t *wave, int32_t wavenum);
+    void Setwave(const Wave *wave);
+    void Setrate(uint32_t rate); // 16.16 fixed point points per tick
+    uint32_t Getrate(void);
     void Dumpwave(void);
-    uint16_t *Getwave(void);
+    const Wave *Getwave(void);
     VCO *GetVCO(void);
+    DACBus *GetBus(void);
     int8_t m_dacnum;
     void SetVCO(VCO *vco);
     bool DinOK(int32_t din, int16_t offset);
@@ -83,13 +102,21 @@ class LTC2668 // Linear Technologies 2668 16 channel 16-bit DAC chip with SPI in
     void Setspan(voltspan span);
     void Voutall(int32_t din);                     // Send digital input value to all DACs on chip
     void Vchk(int32_t din);                        // Send digital input value to the DAC
-    void Adj(int32_t width, bool printit = false); // adjust din up or down 1 toward frequency
+    void Adj(int32_t width, bool printit = false); // PI control of din toward the target width
     void Wadj(bool printit = false);               // adjust din up or down 1 toward frequency
     void Vout(int32_t din, bool adjust = false);   // Send digital input value to the DAC.
                                                    // Default to no adjustment.
     void Voct(int8_t octave, int8_t halfstep, bool clr = false);
     void Vmidi(int8_t midinumber, bool clr = false);
+    void Begin(void);  // following writes only load the input register ("write code n")
+    void End(void);    // following writes update the DAC ("write code n, update n")
+    void Commit(void); // End and make all channels of the chip go live with one "update all"
+    void Settoggle(int32_t dina, int32_t dinb); // load input registers A and B for toggling
+    void Cleartoggle(void);                     // back to register A only
     int16_t GetVOUT(void);
+    int16_t Getvouts(void); // count of Vout calls, a change means the output was played
+    int32_t Getdin(void);   // the din of the last Vout or Adj
+    bool Sounding(void);    // the wave has been started and has not ended
     int32_t Getvoutdin(void);
     int32_t Getvoctdin(void);
     OffsetVals Getoffsetvals(void);
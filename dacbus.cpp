@@ -0,0 +1,366 @@
+// dacbus.cpp ... Contains the DACBus class which queues LTC2668 command frames for one SPI channel
+#include "mbed.h"
+#include "dacbus.h"
+
+DACBusPtr DACBUSES[NUMBERDACBUSES];
+
+DACBus::DACBus(int8_t busnum, typeof(SPI) *spi, typeof(DigitalOut) *spinss)
+{
+    m_busnum = busnum & 0x03; // only 4 LTC2668 chips
+    m_spi = spi, m_spinss = spinss;
+    m_head = 0, m_tail = 0, m_queued = 0, m_sent = 0;
+    m_busy = false, m_hold = 0;
+    m_overruns = 0, m_errors = 0;
+    m_known = 0, m_dirty = 0; // codes on the wire are unknown until written
+    m_toggle = 0, m_tgb = false, m_tgp = NULL;
+    m_written = 0, m_suppressed = 0;
+    m_start = 0, m_done = 0, m_burst = 0, m_maxburst = 0, m_inburst = false;
+#if DEVICE_SPI_ASYNCH
+    m_async = true;
+#else
+    m_async = false;
+#endif
+    DACBUSES[m_busnum] = this;
+}
+
+void DACBus::SetAsync(bool async)
+{
+#if DEVICE_SPI_ASYNCH
+    while (Busy())
+        ;
+    m_async = async;
+#endif
+}
+
+bool DACBus::Busy(void)
+{
+    return (m_busy || m_queued != m_sent);
+}
+
+bool DACBus::Enqueue(const char *send, uint32_t *seq)
+{ // called with interrupts disabled, false when the queue is full, otherwise *seq is the frame's sequence number
+    if (m_queued - m_sent >= DACBUS_FRAMES)
+        return (false);
+    memcpy(m_frames[m_head], send, DACBUS_FRAMESIZE);
+    m_head = (m_head + 1) & (DACBUS_FRAMES - 1);
+    ++m_queued;
+    *seq = m_queued;
+    if (!m_hold)
+        Kick();
+    return (true);
+}
+
+bool DACBus::Post(uint8_t command, int8_t channel, uint16_t code, uint32_t *seq)
+{ // called with interrupts disabled, queue a write code frame unless the channel already has the code
+    // false when the queue is full, otherwise *seq is the sequence number to wait for
+    char send[DACBUS_FRAMESIZE];
+    m_dirty &= ~(1 << channel); // a staged code is older than this one
+    if ((m_known & ~m_toggle & (1 << channel)) && m_shadow[channel] == code)
+    {
+        m_suppressed++;
+        *seq = m_queued;
+        return (true);
+    }
+    send[0] = command | channel;
+    send[1] = code >> 8;
+    send[2] = code & 0xff;
+    if (!m_async)
+    { // the original blocking path
+        m_spinss->write(0);
+        m_spi->write(send, DACBUS_FRAMESIZE, m_recv, DACBUS_FRAMESIZE);
+        m_spinss->write(1);
+        *seq = m_queued;
+    }
+    else if (!Enqueue(send, seq))
+        return (false);
+    m_shadow[channel] = code;
+    m_known |= 1 << channel;
+    m_written++;
+    return (true);
+}
+
+void DACBus::Wait(uint32_t seq, char *recv)
+{ // threads keep the blocking behavior, wait until the frame is on the wire
+    if (core_util_is_isr_active() || m_hold)
+        return; // held frames are sent by Flush
+    while ((int32_t)(m_sent - seq) < 0)
+        ;
+    if (recv)
+        memcpy(recv, m_recv, DACBUS_FRAMESIZE);
+}
+
+void DACBus::Send(const char *send, char *recv)
+{
+    uint32_t seq;
+    if (!m_async)
+    { // the original blocking path
+        m_spinss->write(0);
+        m_spi->write(send, DACBUS_FRAMESIZE, recv ? recv : m_recv, DACBUS_FRAMESIZE);
+        m_spinss->write(1);
+        return;
+    }
+    core_util_critical_section_enter();
+    if (m_hold)
+        Sync(); // codes staged before this frame go first
+    while (!Enqueue(send, &seq))
+    {
+        core_util_critical_section_exit();
+        if (core_util_is_isr_active())
+        { // the queue is full and an ISR cannot wait for it to drain
+            m_overruns++;
+            return;
+        }
+        core_util_critical_section_enter();
+    }
+    core_util_critical_section_exit();
+    Wait(seq, recv);
+}
+
+void DACBus::Code(uint8_t command, int8_t channel, uint16_t code, char *recv)
+{ // send a write code command (0x00, 0x20 or 0x30) only if the channel's code changes
+    uint32_t seq;
+    channel &= 0x0f;
+    command &= 0xf0;
+    if (m_hold)
+    { // a FuncTimer tick is running, only the last code for the channel is sent by Sync
+        Stage(command, channel, code);
+        return;
+    }
+    core_util_critical_section_enter();
+    while (!Post(command, channel, code, &seq))
+    {
+        core_util_critical_section_exit();
+        if (core_util_is_isr_active())
+        {
+            m_overruns++;
+            return;
+        }
+        core_util_critical_section_enter();
+    }
+    core_util_critical_section_exit();
+    Wait(seq, recv);
+}
+
+void DACBus::Codeall(uint16_t code, char *recv)
+{ // write code to all channels and update all
+    char send[DACBUS_FRAMESIZE];
+    send[0] = 0xa0;
+    send[1] = code >> 8;
+    send[2] = code & 0xff;
+    core_util_critical_section_enter();
+    for (int channel = 0; channel < DACBUS_CHANNELS; channel++)
+        m_shadow[channel] = code;
+    m_known = 0xffff;
+    m_dirty = 0;
+    m_written++;
+    core_util_critical_section_exit();
+    Send(send, recv);
+}
+
+void DACBus::Updateall(void)
+{ // copy every channel's input register to its DAC register
+    char send[DACBUS_FRAMESIZE];
+    send[0] = 0x90;
+    send[1] = 0;
+    send[2] = 0;
+    Send(send);
+}
+
+void DACBus::Stage(uint8_t command, int8_t channel, uint16_t code)
+{
+    channel &= 0x0f;
+    core_util_critical_section_enter();
+    if (m_dirty & (1 << channel))
+        m_suppressed++; // the earlier staged code is replaced before it was sent
+    m_pending[channel] = code;
+    m_pendingcmd[channel] = command & 0xf0;
+    m_dirty |= 1 << channel;
+    core_util_critical_section_exit();
+}
+
+void DACBus::Sync(void)
+{ // queue the dirty channels, frames that do not fit stay dirty for the next Sync
+    uint32_t seq;
+    core_util_critical_section_enter();
+    for (int8_t channel = 0; m_dirty && channel < DACBUS_CHANNELS; channel++)
+    {
+        if (!(m_dirty & (1 << channel)))
+            continue;
+        if (!Post(m_pendingcmd[channel], channel, m_pending[channel], &seq))
+        {
+            m_dirty |= 1 << channel;
+            m_overruns++;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+void DACBus::Forget(int8_t channel)
+{
+    core_util_critical_section_enter();
+    m_known &= ~(1 << (channel & 0x0f));
+    core_util_critical_section_exit();
+}
+
+void DACBus::Toggleselect(int8_t channel, bool toggle)
+{ // toggle select command, the data is the mask of toggled channels
+    char send[DACBUS_FRAMESIZE];
+    core_util_critical_section_enter();
+    if (toggle)
+        m_toggle |= 1 << (channel & 0x0f);
+    else
+        m_toggle &= ~(1 << (channel & 0x0f));
+    m_known &= ~(1 << (channel & 0x0f));
+    send[0] = 0xc0;
+    send[1] = m_toggle >> 8;
+    send[2] = m_toggle & 0xff;
+    core_util_critical_section_exit();
+    Send(send);
+}
+
+void DACBus::Toggle(void)
+{
+    Toggle(!m_tgb);
+}
+
+void DACBus::Toggle(bool tgb)
+{ // with the TGP pin a toggle costs no SPI traffic, otherwise one global toggle command
+    char send[DACBUS_FRAMESIZE];
+    m_tgb = tgb;
+    if (m_tgp)
+    {
+        m_tgp->write(m_tgb);
+        return;
+    }
+    send[0] = 0xd0;
+    send[1] = 0;
+    send[2] = m_tgb;
+    Send(send);
+}
+
+void DACBus::SetTGP(typeof(DigitalOut) *tgp)
+{
+    m_tgp = tgp;
+}
+
+uint32_t DACBus::Getwritten(void)
+{
+    return (m_written);
+}
+
+uint32_t DACBus::Getsuppressed(void)
+{
+    return (m_suppressed);
+}
+
+uint32_t DACBus::Getburst(void)
+{
+    return (m_burst);
+}
+
+void DACBus::Hold(void)
+{
+    core_util_critical_section_enter();
+    m_hold++;
+    core_util_critical_section_exit();
+}
+
+void DACBus::Flush(void)
+{
+    core_util_critical_section_enter();
+    if (m_hold > 0)
+        m_hold--;
+    if (!m_hold)
+    {
+        Sync();
+        Kick();
+    }
+    core_util_critical_section_exit();
+}
+
+void DACBus::Kick(void)
+{ // start the frame at the tail, called with interrupts disabled or from the SPI interrupt
+#if DEVICE_SPI_ASYNCH
+    if (m_busy || m_head == m_tail)
+        return;
+    if (!m_inburst)
+    {
+        m_inburst = true;
+        m_start = us_ticker_read();
+    }
+    m_busy = true;
+    m_spinss->write(0);
+    m_spi->transfer(m_frames[m_tail], DACBUS_FRAMESIZE, m_recv, DACBUS_FRAMESIZE,
+                    callback(this, &DACBus::Done), SPI_EVENT_COMPLETE | SPI_EVENT_ERROR);
+#endif
+}
+
+void DACBus::Done(int event)
+{ // SPI transfer complete, latch the frame and start the next one
+    m_spinss->write(1);
+    if (event & SPI_EVENT_ERROR)
+    { // the frame is lost, the waiters still get their sequence numbers
+        m_errors++;
+        m_known = 0; // the codes on the wire are unknown until written again
+    }
+    m_tail = (m_tail + 1) & (DACBUS_FRAMES - 1);
+    m_sent++;
+    m_busy = false;
+    if (!m_hold)
+        Kick();
+    if (!m_busy)
+    { // the queue is empty, the burst is finished
+        m_inburst = false;
+        m_done = us_ticker_read();
+        m_burst = m_done - m_start;
+        if (m_burst > m_maxburst)
+            m_maxburst = m_burst;
+    }
+}
+
+char *DACBus::print(void)
+{
+    sprintf(m_buffer, "DACBus %d async %d queued %lu sent %lu overruns %lu errors %lu written %lu suppressed %lu burst %lu max %lu us\r\n",
+            m_busnum,
+            m_async,
+            (long unsigned int)m_queued,
+            (long unsigned int)m_sent,
+            (long unsigned int)m_overruns,
+            (long unsigned int)m_errors,
+            (long unsigned int)m_written,
+            (long unsigned int)m_suppressed,
+            (long unsigned int)m_burst,
+            (long unsigned int)m_maxburst);
+    return m_buffer;
+}
+
+void DACBusHold(void)
+{
+    for (int i = 0; i < NUMBERDACBUSES; i++)
+        if (DACBUSES[i])
+            DACBUSES[i]->Hold();
+}
+
+void DACBusFlush(void)
+{
+    for (int i = 0; i < NUMBERDACBUSES; i++)
+        if (DACBUSES[i])
+            DACBUSES[i]->Flush();
+}
+
+uint32_t DACBusWait(void)
+{ // the buses run in parallel so a batch takes as long as its longest burst
+    uint32_t burst = 0;
+    for (int i = 0; i < NUMBERDACBUSES; i++)
+    {
+        if (DACBUSES[i])
+        {
+            while (DACBUSES[i]->Busy())
+                ;
+            if (DACBUSES[i]->Getburst() > burst)
+                burst = DACBUSES[i]->Getburst();
+        }
+    }
+    return (burst);
+}
@@ -0,0 +1,76 @@
+#ifndef DACBUS_H
+#define DACBUS_H
+
+#include "mbed.h"
+
+class DACBus;
+
+#define NUMBERDACBUSES 4
+#define DACBUS_FRAMES 64 // must be a power of 2
+#define DACBUS_FRAMESIZE 3
+#define DACBUS_CHANNELS 16
+typedef DACBus *DACBusPtr;
+extern DACBusPtr DACBUSES[NUMBERDACBUSES];
+
+class DACBus // One LTC2668 chip on its own SPI channel (spi5, spi4, spi1, spi6)
+// Commands are queued as 3-byte frames and sent with asynchronous SPI transfers.  The LTC2668
+// latches a command on the rising edge of NSS, so each frame is its own transfer and the
+// completion callback starts the next one.  Interrupt code only queues frames and returns.
+// A shadow of the last code written to each channel suppresses writes that would not change the
+// output.  While the bus is held codes are staged per channel and only the last one is sent.
+{
+  private:
+    typeof(SPI) *m_spi;
+    typeof(DigitalOut) *m_spinss;
+    int8_t m_busnum;
+    char m_frames[DACBUS_FRAMES][DACBUS_FRAMESIZE];
+    char m_recv[DACBUS_FRAMESIZE];
+    volatile uint16_t m_head, m_tail;
+    volatile uint32_t m_queued, m_sent;
+    volatile bool m_busy, m_inburst;
+    volatile int8_t m_hold;
+    bool m_async;
+    uint32_t m_overruns, m_errors; // m_errors are frames the SPI failed, still counted as sent
+    uint16_t m_shadow[DACBUS_CHANNELS];  // last code sent to each channel
+    uint16_t m_pending[DACBUS_CHANNELS]; // codes staged while held
+    uint8_t m_pendingcmd[DACBUS_CHANNELS];
+    uint16_t m_known, m_dirty, m_toggle; // one bit per channel
+    bool m_tgb;                          // global toggle bit, register B drives the toggled DACs
+    typeof(DigitalOut) *m_tgp;           // toggle pin, NULL when the global toggle command is used
+    uint32_t m_written, m_suppressed;
+    uint32_t m_start, m_done, m_burst, m_maxburst; // us_ticker times of the last burst
+    char m_buffer[200]; // print's ten counters at full width
+    bool Enqueue(const char *send, uint32_t *seq);
+    bool Post(uint8_t command, int8_t channel, uint16_t code, uint32_t *seq);
+    void Wait(uint32_t seq, char *recv);
+    void Kick(void);
+    void Done(int event);
+
+  public:
+    DACBus(int8_t busnum, typeof(SPI) *spi, typeof(DigitalOut) *spi_nss);
+    void Send(const char *send, char *recv = NULL); // queue a frame, threads wait until it is on the wire
+    void Code(uint8_t command, int8_t channel, uint16_t code, char *recv = NULL); // only sent if changed
+    void Codeall(uint16_t code, char *recv = NULL); // write code to all channels and update all
+    void Updateall(void);                           // staged codes of all channels go live
+    void Stage(uint8_t command, int8_t channel, uint16_t code); // mark the channel dirty
+    void Sync(void);                                // send the dirty channels which changed
+    void Forget(int8_t channel);                    // the next code for the channel is always sent
+    void Toggleselect(int8_t channel, bool toggle); // codes for a toggled channel go to register B
+    void Toggle(void);                              // switch all toggled channels between A and B
+    void Toggle(bool tgb);
+    void SetTGP(typeof(DigitalOut) *tgp);
+    void Hold(void);                                // queue frames without sending until Flush
+    void Flush(void);                               // start sending the frames queued since Hold
+    void SetAsync(bool async);                      // false sends each frame with a blocking SPI write
+    bool Busy(void);
+    uint32_t Getwritten(void);
+    uint32_t Getsuppressed(void);
+    uint32_t Getburst(void); // microseconds the last burst took from first frame to last
+    char *print(void);
+};
+
+void DACBusHold(void);  // called at the beginning of a FuncTimer tick
+void DACBusFlush(void); // called at the end of a FuncTimer tick, one burst per bus
+uint32_t DACBusWait(void); // wait for all buses to finish, returns the longest burst in microseconds
+
+#endif
@@ -0,0 +1,128 @@
+// envbank.cpp ... EnvBank class which runs many envelopes from parallel arrays
+#include "mbed.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "envelope.h"
+#include "envbank.h"
+
+EnvBank::EnvBank(void)
+{
+    Clear();
+}
+
+void EnvBank::Clear(void)
+{
+    m_count = 0, m_changecount = 0, m_segcount = 0, m_failed = 0;
+}
+
+int8_t EnvBank::Add(Envelope *envelope)
+{ // the segments are copied, later changes to the Envelope need Clear and Add again
+    Segment *segment;
+    uint16_t segments = envelope->Getsegments();
+    uint8_t env = m_count;
+    int64_t change;
+    if (m_count >= ENVBANK_SIZE || !segments || m_segcount + segments > ENVBANK_SEGMENTS || !envelope->GetDAC())
+    {
+        m_failed++;
+        return (-1);
+    }
+    m_first[env] = m_segcount;
+    for (uint16_t i = 0; i < segments; i++, m_segcount++)
+    {
+        segment = envelope->Getsegment(i);
+        m_begin[m_segcount] = segment->Getbegin();
+        m_end[m_segcount] = segment->Getend();
+        m_ticks[m_segcount] = segment->Getticks();
+        m_segcurve[m_segcount] = segment->Getcurve();
+        change = m_segcurve[m_segcount] == CurveLinear ? (int64_t)(m_end[m_segcount] - m_begin[m_segcount]) << 32
+                                                       : 1LL << 32;
+        m_seginc[m_segcount] = change / (int64_t)m_ticks[m_segcount]; // the divides are done here, not per tick
+    }
+    m_last[env] = m_segcount;
+    m_repeat[env] = envelope->Getrepeat();
+    m_dac[env] = envelope->GetDAC();
+    m_code[env] = 0;
+    m_left[env] = 0, m_seg[env] = ENVBANK_STOPPED;
+    m_count++;
+    return (env);
+}
+
+void EnvBank::Load(uint8_t env, uint16_t seg)
+{
+    m_seg[env] = seg;
+    m_curve[env] = m_segcurve[seg];
+    m_acc[env] = m_curve[env] == CurveLinear ? (int64_t)m_begin[seg] << 32 : 0;
+    m_inc[env] = m_seginc[seg];
+    m_left[env] = m_ticks[seg];
+}
+
+void EnvBank::Start(int8_t env)
+{
+    if (env < 0 || env >= m_count)
+        return;
+    core_util_critical_section_enter();
+    Load(env, m_first[env]);
+    core_util_critical_section_exit();
+}
+
+void EnvBank::Stop(int8_t env)
+{
+    if (env < 0 || env >= m_count)
+        return;
+    core_util_critical_section_enter();
+    m_left[env] = 0, m_seg[env] = ENVBANK_STOPPED;
+    core_util_critical_section_exit();
+}
+
+uint8_t EnvBank::Next(void)
+{ // the same points as Segment::Next, the last tick of each segment is its end exactly
+    uint8_t changes = 0;
+    uint16_t code, seg;
+    for (uint8_t env = 0; env < m_count; env++)
+    {
+        if (!m_left[env])
+            continue;
+        seg = m_seg[env];
+        if (--m_left[env])
+        {
+            m_acc[env] += m_inc[env];
+            code = m_curve[env] == CurveLinear ? (uint16_t)(m_acc[env] >> 32)
+                                               : Curvepoint(m_curve[env], (uint32_t)(m_acc[env] >> 8), m_begin[seg], m_end[seg]);
+        }
+        else
+        {
+            code = m_end[seg];
+            if (++seg < m_last[env])
+                Load(env, seg);
+            else if (m_repeat[env])
+                Load(env, m_first[env]);
+            else
+                m_seg[env] = ENVBANK_STOPPED; // m_left is 0
+        }
+        if (code != m_code[env])
+        {
+            m_code[env] = code;
+            m_changes[changes++] = env;
+        }
+    }
+    m_changecount = changes;
+    return (changes);
+}
+
+void EnvBank::Emit(void)
+{ // the FuncTimer tick holds the DAC buses, so the codes are only queued
+    for (uint8_t i = 0; i < m_changecount; i++)
+        m_dac[m_changes[i]]->Vout(m_code[m_changes[i]]);
+}
+
+char *EnvBank::print(void)
+{
+    uint8_t running = 0;
+    for (uint8_t env = 0; env < m_count; env++)
+        if (m_left[env])
+            running++;
+    sprintf(m_buffer, "EnvBank %d envelopes %d running %d segments %d changed %d not added\r\n",
+            m_count, running, m_segcount, m_changecount, m_failed);
+    return m_buffer;
+}
@@ -0,0 +1,51 @@
+// envbank.h
+// EnvBank keeps the state of many envelopes in parallel arrays so a FuncTimer tick advances all of them
+// in one loop
+#ifndef ENVBANK_H
+#define ENVBANK_H
+
+#include "mbed.h"
+#include "envelope.h"
+
+#define ENVBANK_SIZE 64                      // envelopes in a bank
+#define ENVBANK_SEGMENTS (ENVBANK_SIZE * 16) // segments of all the bank's envelopes, the demo envelopes have 10
+#define ENVBANK_STOPPED 0xffff               // m_seg of an envelope which is not running
+
+class EnvBank // The segments of the envelopes are copied in when they are added, with the increment per
+// tick worked out, so a tick is an add and a compare per envelope and a table lookup for the curved
+// segments.  The envelopes whose DAC code changed are listed and Emit sends only those.
+{
+  private:
+    uint8_t m_count, m_changecount;
+    uint16_t m_segcount, m_failed; // m_failed counts the Adds which did not fit
+    // per envelope
+    int64_t m_acc[ENVBANK_SIZE];   // 32.32 fixed point din, or the progress of a curved segment
+    int64_t m_inc[ENVBANK_SIZE];   // added to m_acc every tick
+    uint32_t m_left[ENVBANK_SIZE]; // ticks to the end of the segment, 0 when stopped
+    uint16_t m_seg[ENVBANK_SIZE];  // the current segment
+    uint16_t m_code[ENVBANK_SIZE]; // last code for the DAC
+    uint8_t m_curve[ENVBANK_SIZE]; // SegCurve of the current segment
+    bool m_repeat[ENVBANK_SIZE];
+    uint16_t m_first[ENVBANK_SIZE], m_last[ENVBANK_SIZE]; // the envelope's segments are m_first to m_last - 1
+    LTC2668 *m_dac[ENVBANK_SIZE];
+    uint8_t m_changes[ENVBANK_SIZE]; // envelopes whose code changed in the last Next
+    // per segment
+    int32_t m_begin[ENVBANK_SEGMENTS], m_end[ENVBANK_SEGMENTS];
+    uint32_t m_ticks[ENVBANK_SEGMENTS];
+    int64_t m_seginc[ENVBANK_SEGMENTS];
+    uint8_t m_segcurve[ENVBANK_SEGMENTS];
+    char m_buffer[80];
+    void Load(uint8_t env, uint16_t seg);
+
+  public:
+    EnvBank(void);
+    void Clear(void);
+    int8_t Add(Envelope *envelope); // returns the bank's envelope number, -1 when the bank is full
+    void Start(int8_t env);
+    void Stop(int8_t env);
+    uint8_t Next(void); // one tick of every envelope, returns the number of changed codes
+    void Emit(void);    // Vout of the changed codes
+    char *print(void);
+};
+
+#endif
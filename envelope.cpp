@@ -18,10 +18,12 @@ Segment::Segment(Envelope *envelope, segfunctype function)
 void Segment::Init(segfunctype function)
 {
     m_function = function;
-    m_begin = 0, m_end = 0, m_point = 0, m_hold = 1, m_lastpoint = 0;
-    m_intervals = 0;    // number of time-intervals to go from begin to end
+    m_begin = 0, m_end = 0, m_point = 0, m_hold = SEGMENT_HOLDONE, m_lastpoint = 0;
+    m_intervals = 1;    // number of time-intervals to go from begin to end
     m_change = 0;       // every Interval change point by this amount.  This is <<16 to get accuracy
     m_change_up = true; // if true change is positive otherwise negative
+    m_ticks = 1, m_inc = 0;
+    m_curve = CurveLinear;
     Start();
 }
 
@@ -31,32 +33,91 @@ void Segment::SetFunc(segfunctype function)
 }
 
 void Segment::ChangeInc(uint32_t inc)
-{
+{ // a steeper or shallower line over the same intervals, so the end moves
+    int64_t end;
     m_change += inc;
+    end = ((uint64_t)m_change * m_intervals) >> 16;
+    end = m_begin + (m_change_up ? end : -end);
+    m_end = end < 0 ? 0 : end > 0xffff ? 0xffff : (int32_t)end;
+    Rate();
 }
 
 void Segment::Start(void)
 {
-    m_cnt = 0;     // number of times Next has been called
-    m_holdcnt = 0; // number of times Next has been called Next. m_holdcnt increments from 0 to m_hold
+    m_acc = m_curve == CurveLinear ? (int64_t)m_begin << 32 : 0;
+    m_left = m_ticks; // the segment is finished when m_left reaches 0
+    Rate();
+}
+
+void Segment::Rate(void)
+{ // the divide is only done when the segment changes, never per tick
+    int64_t target = m_curve == CurveLinear ? (int64_t)m_end << 32 : 1LL << 32;
+    m_inc = m_left ? (target - m_acc) / (int64_t)m_left : 0;
+}
+
+uint16_t Curvepoint(uint8_t curve, uint32_t progress, int32_t begin, int32_t end)
+{ // 8 bits of the 24 bit progress pick the table points and the other 16 interpolate between them
+    const uint16_t *table = CURVES[curve - 1];
+    uint32_t point = progress >> 16;
+    int32_t shape = table[point] + (((int32_t)(table[point + 1] - table[point]) * (int32_t)(progress & 0xffff)) >> 16);
+    return (uint16_t)(begin + (((int64_t)(end - begin) * shape) >> 16));
+}
+
+void Segment::SetCurve(SegCurve curve)
+{
+    m_curve = curve < NUMBERCURVES ? curve : CurveLinear;
+    Start();
+}
+
+int32_t Segment::Getbegin(void)
+{
+    return (m_begin);
 }
+
+int32_t Segment::Getend(void)
+{
+    return (m_end);
+}
+
+uint32_t Segment::Getticks(void)
+{
+    return (m_ticks);
+}
+
+SegCurve Segment::Getcurve(void)
+{
+    return (m_curve);
+}
+
+void Segment::SetHold(uint32_t hold)
+{ // the ticks already played are kept and the rest of the line is spread over the new ticks
+    uint32_t played = m_ticks - m_left;
+    uint64_t ticks;
+    m_hold = hold ? hold : 1;
+    ticks = ((uint64_t)m_intervals * m_hold + (SEGMENT_HOLDONE >> 1)) >> 16;
+    m_ticks = ticks < 1 ? 1 : ticks > 0xffffffff ? 0xffffffff : (uint32_t)ticks;
+    m_left = m_ticks > played ? m_ticks - played : 1;
+    Rate();
+}
+
 void Segment::IncHold(int16_t inc)
 {
-    m_hold += inc;
+    int64_t hold = (int64_t)m_hold + ((int64_t)inc << 16);
+    SetHold(hold < SEGMENT_HOLDONE ? SEGMENT_HOLDONE : hold > 0x7fffffff ? 0x7fffffff : (uint32_t)hold);
 }
 
 void Segment::Dump(void)
 {
-    printf("DAC %2d, %2d ints from %d to %d at %s%.2f Hold %d Hcnt %d cnt %d F%p D%x\n\r",
+    printf("DAC %2d, %2d ints from %d to %d at %s%.2f Hold %.2f ticks %lu left %lu F%p D%x\n\r",
            m_envelope->GetDAC()->m_dacnum,
            m_intervals,
            m_begin,
            m_end,
            m_change_up ? "+" : "-",
            (float)m_change / (float)0x10000,
-           m_hold,
-           m_holdcnt,
-           m_cnt,
+           (float)m_hold / (float)SEGMENT_HOLDONE,
+           (long unsigned int)m_ticks,
+           (long unsigned int)m_left,
            m_function,
            m_point);
     while (!Next(false))
@@ -64,15 +125,18 @@ void Segment::Dump(void)
     //printf("\n\r");
 }
 
-void Segment::Calc(int32_t begin, int32_t end, int16_t intervals, int16_t hold)
+void Segment::Calc(int32_t begin, int32_t end, int16_t intervals, int16_t hold, SegCurve curve)
 {
-    m_begin = begin, m_end = end, m_hold = hold;
-    m_intervals = !intervals ? 1 : intervals; // number of time-intervals to go from begin to end
-    Start();
+    m_begin = begin, m_end = end;
+    m_curve = curve < NUMBERCURVES ? curve : CurveLinear;
+    m_intervals = intervals < 1 ? 1 : intervals; // number of time-intervals to go from begin to end
     m_change = (abs(end - begin) << 16) / m_intervals; // m_change is times 65536 (<<16)
     m_change_up = (end - begin) >= 0;
     m_point = begin;
     m_lastpoint = 0;
+    m_ticks = 1, m_left = 1;
+    SetHold((uint32_t)(hold < 1 ? 1 : hold) << 16);
+    Start();
 }
 
 void Segment::Set(bool set)
@@ -89,30 +153,23 @@ void Segment::Set(bool set)
 }
 
 bool Segment::Next(bool set)
-{
-    if (m_change_up)
-        m_point = ((m_cnt * m_change) >> 16) + m_begin; // m_change has been shifted <<16 so must be shifted back
-    else
-        m_point = -((m_cnt * m_change) >> 16) + m_begin; // m_change has been shifted <<16 so must be shifted back
-    if (m_cnt >= m_intervals)
-        m_point = m_end;
-    Set(set = set);
-    m_holdcnt++;
-    if (m_holdcnt >= m_hold)
+{ // the first tick is one step from m_begin, which the segment before ended on, and the last is m_end
+    if (--m_left)
     {
-        m_holdcnt = 0;
-        m_cnt++;
-        if (m_cnt >= m_intervals)
-        {
-            m_cnt = 0;
-            m_lastpoint = 0;
-            return true;
-        }
+        m_acc += m_inc;
+        m_point = m_curve == CurveLinear ? (uint16_t)(m_acc >> 32)
+                                         : Curvepoint(m_curve, (uint32_t)(m_acc >> 8), m_begin, m_end); // progress is below 1 << 24 until the last tick
+        Set(set);
+        return false;
     }
-    return false;
+    m_point = m_end;
+    Set(set);
+    Start();
+    m_lastpoint = 0;
+    return true;
 }
 
-ENVPtr *ENVS = new ENVPtr[NUMBERENVS]();
+ENVPtr ENVS[NUMBERENVS];
 
 Envelope::Envelope(int8_t num, LTC2668 *dac, bool repeat, bool printit, begfunctype begfunction, endfunctype endfunction)
 {
@@ -156,7 +213,7 @@ void Envelope::Info(void)
     printf("Env %2d, DAC %2d, Segments: %d, SCnt: %d, RCnt: %d, Stop: %d, Repeat: %d, Finished: %d\n\r",
            m_num,
            m_dac->m_dacnum,
-           m_segments.size(),
+           (int)m_segments.size(),
            m_segcnt,
            m_repeats,
            m_stopflag,
@@ -165,10 +222,11 @@ void Envelope::Info(void)
 }
 
 void Envelope::Add(int32_t begin, int32_t end,
-                   int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction)
+                   int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction,
+                   SegCurve curve)
 {
     Segment seg = Segment(this, segfunction);
-    seg.Calc(begin, end, intervals, hold = hold);
+    seg.Calc(begin, end, intervals, hold = hold, curve);
     if (segment == -1)
     {
         m_segments.push_back(seg);
@@ -181,13 +239,14 @@ void Envelope::Add(int32_t begin, int32_t end,
 
 void Envelope::Add(int8_t begoctave, int8_t beghalfstep,
                    int8_t endoctave, int8_t endhalfstep,
-                   int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction)
+                   int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction,
+                   SegCurve curve)
 {
     Segment seg = Segment(this, segfunction);
     // this will throw error if dac doesn't have a VCO
     seg.Calc(m_dac->GetVCO()->Dinh(begoctave, beghalfstep),
              m_dac->GetVCO()->Dinh(endoctave, endhalfstep),
-             intervals, hold = hold);
+             intervals, hold = hold, curve);
     if (segment == -1)
     {
         m_segments.push_back(seg);
@@ -203,6 +262,27 @@ void Envelope::SetSegFunc(segfunctype segfunction)
     m_segments[m_segments.size() - 1].SetFunc(segfunction);
 }
 
+uint16_t Envelope::Getsegments(void)
+{
+    return (m_segments.size());
+}
+
+Segment *Envelope::Getsegment(uint16_t segment)
+{
+    return (&m_segments[segment]);
+}
+
+bool Envelope::Getrepeat(void)
+{
+    return (m_repeat);
+}
+
+void Envelope::SetCurve(SegCurve curve)
+{
+    for (m_ui = 0; m_ui < m_segments.size(); m_ui++)
+        m_segments[m_ui].SetCurve(curve);
+}
+
 void Envelope::Replace(int32_t begin, int32_t end,
                        int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction)
 { // replaces a line segment with new values
@@ -308,7 +388,7 @@ void Envelope::Dump(void)
     }
 }
 
-ADSRPtr *ADSRS = new ADSRPtr[NUMBERADSRS]();
+ADSRPtr ADSRS[NUMBERADSRS];
 
 Adsr::Adsr(int8_t num, LTC2668 *dac, bool repeat, bool printit, begfunctype begfunction, endfunctype endfunction)
     : Envelope(-1, dac, repeat, printit, begfunction, endfunction)
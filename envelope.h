@@ -12,18 +12,40 @@ class Adsr;
 typedef void (*segfunctype)(void);
 #define NUMBERENVS 16
 typedef Envelope *ENVPtr;
-extern ENVPtr *ENVS;
+extern ENVPtr ENVS[NUMBERENVS];
+
+#define SEGMENT_HOLDONE 0x10000 // 16.16 fixed point hold, one tick per interval
+
+enum SegCurve
+{
+    CurveLinear, // a straight line in DAC codes
+    CurveExp,    // slow then fast
+    CurveLog,    // fast then slow, like an RC charging
+    CurveS,      // slow at both ends
+    NUMBERCURVES
+};
+#define CURVE_POINTS 256 // points of each curve table, the fraction between two points is interpolated
+extern const uint16_t CURVES[NUMBERCURVES - 1][CURVE_POINTS + 1]; // 0 to 65535, CurveLinear has no table
+uint16_t Curvepoint(uint8_t curve, uint32_t progress, int32_t begin, int32_t end); // 24 bit progress
 
 class Segment // Segment is a class of points on a line connecting a beginning and ending voltage
+// A 32.32 fixed point accumulator steps from m_begin by m_inc every tick, so a tick is one add and one
+// compare.  The hold is a 16.16 fixed point number of ticks per interval, and the last tick of the
+// segment is m_end exactly.  A curved segment's accumulator is its progress from 0 to 1 << 32 instead,
+// which looks up the shape in its CURVES table.
 {
   private:
     Envelope *m_envelope;
     segfunctype m_function;
-    int16_t m_hold, m_holdcnt;
+    uint32_t m_hold; // 16.16 fixed point ticks per interval
     int32_t m_begin, m_end;
     uint16_t m_point, m_lastpoint;
-    uint32_t m_change, m_cnt, m_intervals;
+    uint32_t m_change, m_intervals; // m_change is the din change per interval << 16, for Dump and ChangeInc
     bool m_change_up;
+    int64_t m_acc, m_inc;     // 32.32 fixed point din or curve progress and its change per tick
+    uint32_t m_ticks, m_left; // ticks in the segment and ticks to go
+    SegCurve m_curve;
+    void Rate(void); // m_inc from where the accumulator is to m_end over the ticks left
 
   public:
     Segment(Envelope *envelope, segfunctype function = NULL);
@@ -32,10 +54,16 @@ class Segment // Segment is a class of points on a line connecting a beginning a
     void Start(void);
     void ChangeInc(uint32_t inc);
     void Dump(void);
-    void Calc(int32_t begin, int32_t end, int16_t intervals, int16_t hold = 1);
+    void Calc(int32_t begin, int32_t end, int16_t intervals, int16_t hold = 1, SegCurve curve = CurveLinear);
     void Set(bool set = true);
     bool Next(bool set = true);
     void IncHold(int16_t inc);
+    void SetHold(uint32_t hold);   // 16.16 fixed point ticks per interval
+    void SetCurve(SegCurve curve); // restarts the segment
+    int32_t Getbegin(void);
+    int32_t Getend(void);
+    uint32_t Getticks(void);
+    SegCurve Getcurve(void);
 };
 
 typedef void (*begfunctype)(void);
@@ -62,16 +90,22 @@ class Envelope // Envelope is a class of several 'Segment' objects
     void IncSegHold(int16_t inc);
     void IncSegChange(uint32_t inc = -8388608);
     void SetSegFunc(segfunctype segfunction);
+    void SetCurve(SegCurve curve); // every segment, each one restarts
+    uint16_t Getsegments(void);
+    Segment *Getsegment(uint16_t segment);
+    bool Getrepeat(void);
     uint32_t m_segcnt;
     LTC2668 *GetDAC(void);
     void Info(void);
     void Clear(void);
     void Add(int32_t begin,
              int32_t end,
-             int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction);
+             int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction,
+             SegCurve curve = CurveLinear);
     void Add(int8_t begoctave, int8_t beghalfstep,
              int8_t endoctave, int8_t endhalfstep,
-             int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction);
+             int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction,
+             SegCurve curve = CurveLinear);
     void Replace(int32_t begin,
                  int32_t end,
                  int16_t intervals, int16_t hold, int16_t segment, segfunctype segfunction); // replaces a line segment with new values
@@ -88,7 +122,7 @@ class Envelope // Envelope is a class of several 'Segment' objects
 
 #define NUMBERADSRS 32
 typedef Adsr *ADSRPtr;
-extern ADSRPtr *ADSRS;
+extern ADSRPtr ADSRS[NUMBERADSRS];
 
 class Adsr : public Envelope
 {
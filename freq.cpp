@@ -82,30 +82,71 @@ void FreqTimer::start_action(bool s1, bool s2, bool s3, bool s4)
     __enable_irq();
 }
 
+void FreqTimer::start_dma(bool s1, bool s2, bool s3, bool s4)
+{ // each enabled channel's captures are DMA requests, only the overflow interrupts remain
+    __disable_irq();
+    m_timer->DIER = TIM_DIER_UIE; // set overflow
+    if (s1)
+        m_timer->DIER |= TIM_DIER_CC1DE;
+    if (s2)
+        m_timer->DIER |= TIM_DIER_CC2DE;
+    if (s3)
+        m_timer->DIER |= TIM_DIER_CC3DE;
+    if (s4)
+        m_timer->DIER |= TIM_DIER_CC4DE;
+    __enable_irq();
+}
+
 char *FreqTimer::print()
 {
     sprintf(m_buffer, "Timer %d %12lu %lx %lx %lx %lx %lx %d\r\n",
             m_tnum,
-            m_timer->CNT,
+            (long unsigned int)m_timer->CNT,
             (long unsigned int)&m_timer->CNT,
-            m_timer->ARR,
-            m_timer->PSC,
-            m_timer->CR1,
-            m_timer->SMCR,
+            (long unsigned int)m_timer->ARR,
+            (long unsigned int)m_timer->PSC,
+            (long unsigned int)m_timer->CR1,
+            (long unsigned int)m_timer->SMCR,
             m_overflow);
     return m_buffer;
 }
 
+void FreqTimer::SetPrescaler(uint8_t chnum, uint8_t psc)
+{ // ICxPSC, capture every 1, 2, 4 or 8 edges
+    volatile uint32_t *ccmr = chnum < 2 ? &m_timer->CCMR1 : &m_timer->CCMR2;
+    uint8_t shift = (chnum & 1) ? 10 : 2;
+    *ccmr = (*ccmr & ~(3 << shift)) | ((psc & 3) << shift);
+}
+
 uint32_t FreqTimer::timercount(void)
 {
     return m_timer->CNT;
 }
 
-uint16_t FreqTimer::overflow(void)
+uint32_t FreqTimer::overflow(void)
 {
     return m_overflow;
 }
 
+uint64_t FreqTimer::count64(void)
+{ // the counter extended with m_overflow, an overflow whose interrupt is still pending is counted when
+    // the counter has already wrapped
+    uint32_t overflow, count;
+    core_util_critical_section_enter();
+    overflow = m_overflow;
+    count = m_timer->CNT;
+    if ((m_timer->SR & TIM_SR_UIF) && count < 0x80000000)
+        overflow++;
+    core_util_critical_section_exit();
+    return (((uint64_t)overflow << 32) | count);
+}
+
+uint64_t FreqTimer::stamp64(uint32_t ccr)
+{ // a capture less than one counter wrap old extended to 64 bits, the capture is before count64
+    uint64_t now = count64();
+    return (now - (uint32_t)((uint32_t)now - ccr));
+}
+
 void FreqTimer::irq_ic_timer(void)
 {
     if (m_timer->SR & TIM_SR_UIF)
@@ -148,7 +189,11 @@ void FreqTimer::irq_ic_timer(void)
     // timer overflow
 }
 
-FREQPtr *FREQS = new FREQPtr[NUMBERFREQS];
+FREQPtr FREQS[NUMBERFREQS];
+
+FreqChannel::FreqChannel(void)
+{
+}
 
 FreqChannel::FreqChannel(typeof(GPIOA) fgpio,
                          FreqTimer *ftimer,
@@ -158,7 +203,17 @@ FreqChannel::FreqChannel(typeof(GPIOA) fgpio,
                          volatile uint32_t *fccr,
                          uint32_t af)
 {
-    m_buffer = (char *)malloc(140);
+    Init(fgpio, ftimer, fenable, fport, fchnum, fccr, af);
+}
+
+void FreqChannel::Init(typeof(GPIOA) fgpio,
+                       FreqTimer *ftimer,
+                       uint32_t fenable,
+                       uint8_t fport,
+                       uint8_t fchnum,
+                       volatile uint32_t *fccr,
+                       uint32_t af)
+{
     m_gpio = fgpio;
     m_freq_timer = ftimer;
     m_dac = NULL;
@@ -177,10 +232,17 @@ FreqChannel::FreqChannel(typeof(GPIOA) fgpio,
     m_gpio->PUPDR |= (1 << (2 * m_port));  //  Pull-up mode
     m_freq_timer->SetChannel(this, m_chnum % 4);
     m_count_0 = 0, m_count_1 = 0, m_count_step = false;
-    m_width = 0;
+    m_width = 0, m_samples = 0;
+    m_periods = 0, m_wakeups = 0;
+    m_accum = 0, m_accumcnt = 0;
+    m_interval = FREQUENCY / FREQ_NOTIFYRATE;
+    m_psc = FREQ_MAXPSC; // Publish lowers it, a fast VCO cannot lap the DMA buffer before the first Publish
+    m_freq_timer->SetPrescaler(m_chnum % 4, m_psc);
+    m_mincount = 0xffffffff, m_maxcount = 0, m_jitter = 0;
+    m_dma = NULL, m_stampread = 0, m_polled = 0;
+    m_ringhead = 0, m_ringcount = 0;
+    m_stamp64 = 0;
     m_dac = NULL;
-    Semaphore m_freq_sample(0);
-    int32_t m_semaphore_id;
     FREQS[m_chnum] = this;
 }
 
@@ -201,6 +263,8 @@ uint32_t FreqChannel::GetWidth(void)
 
 uint32_t FreqChannel::GetSampledWidth(void)
 {
+    while (m_freq_sample.wait(0) > 0)
+        ; // widths published before the call are stale
     m_semaphore_id = m_freq_sample.wait(500);
     if (m_semaphore_id == 0 || m_semaphore_id == -1)
     {
@@ -212,16 +276,22 @@ uint32_t FreqChannel::GetSampledWidth(void)
     }
 }
 
-uint32_t FreqChannel::SampledFreq16(void)
+uint32_t FreqChannel::Getsamples(void)
 {
-    if (uint32_t width = GetSampledWidth())
-    {
-        return ((FREQUENCY << 4) / width);
-    }
-    else
-    {
+    return m_samples;
+}
+
+uint32_t FreqChannel::SampledFreq16(uint8_t *confidence)
+{ // wait for the next width, then use the median of the recent periods so one glitch does not count
+    FreqSample sample;
+    if (confidence)
+        *confidence = 0;
+    if (!GetSampledWidth())
         return (0);
-    }
+    sample = Median();
+    if (confidence)
+        *confidence = sample.confidence;
+    return (sample.width ? (FREQUENCY << 4) / sample.width : 0);
 }
 
 uint32_t FreqChannel::Freq16(void)
@@ -262,44 +332,227 @@ float FreqChannel::SampledFreqf(void)
 
 char *FreqChannel::vars()
 {
-    sprintf(m_buffer, "%d %d %12lu %12lu %8.2f %12lu",
+    sprintf(m_buffer, "%d %d %12lu %12lu %8.2f %12lu periods %lu published %lu wakeups %lu psc %d jitter %lu",
             m_chnum,
             m_count_step,
-            m_count_0,
-            m_count_1,
+            (long unsigned int)m_count_0,
+            (long unsigned int)m_count_1,
             Freqf(),
-            m_freq_timer->timercount());
+            (long unsigned int)m_freq_timer->timercount(),
+            (long unsigned int)m_periods,
+            (long unsigned int)m_samples,
+            (long unsigned int)m_wakeups,
+            1 << m_psc,
+            (long unsigned int)m_jitter);
     return m_buffer;
 }
 
+bool FreqChannel::Publish(uint32_t count, uint8_t periods)
+{ // the width is the total count over the periods since the last publish, then the prescaler is
+    // adapted so the capture rate stays under FREQ_MAXCAPTURE and each capture spans more counts
+    // returns true when the prescaler changed
+    uint8_t psc = 0;
+    bool changed = false;
+    m_periods += periods;
+    m_accum += count;
+    m_accumcnt += periods;
+    m_mincount = count < m_mincount ? count : m_mincount;
+    m_maxcount = count > m_maxcount ? count : m_maxcount;
+    if (m_accum < m_interval)
+        return (false);
+    m_width = m_accumcnt > 1 ? m_accum / m_accumcnt : m_accum;
+    m_jitter = (m_maxcount - m_mincount) >> m_psc; // spread of the captured periods in timer counts
+    m_accum = 0, m_accumcnt = 0;
+    m_mincount = 0xffffffff, m_maxcount = 0;
+    while (psc < FREQ_MAXPSC && (m_width << psc) < FREQUENCY / FREQ_MAXCAPTURE)
+        psc++;
+    if (psc != m_psc)
+    { // the capture after the change may cover a different number of periods
+        m_psc = psc;
+        m_freq_timer->SetPrescaler(m_chnum % 4, m_psc);
+        m_count_step = false;
+        if (m_dma) // the timestamps the DMA wrote until now were captured with the old prescaler
+            m_stampread = (FREQ_STAMPS - m_dma->NDTR) & (FREQ_STAMPS - 1);
+        changed = true;
+    }
+    m_samples++;
+    m_freq_sample.release();
+    // release the adjust semaphore only if not adjusted
+    if (m_dac && !m_dac->Getoffsetvals().adjusted)
+    {
+        m_wakeups++;
+        m_dac->GetVCO()->Getvcoadjsem()->release();
+    }
+    return (changed);
+}
+
+void FreqChannel::Setnotifyrate(uint32_t rate)
+{ // 0 publishes every period
+    core_util_critical_section_enter();
+    m_interval = rate ? FREQUENCY / rate : 0;
+    m_accum = 0, m_accumcnt = 0;
+    core_util_critical_section_exit();
+}
+
+uint32_t FreqChannel::Getperiods(void)
+{
+    return m_periods;
+}
+
+uint32_t FreqChannel::Getwakeups(void)
+{
+    return m_wakeups;
+}
+
 void FreqChannel::irq_freq(void)
 {
-    m_ccrdata = *m_ccr; // m_freq_timer->CCR1;
+    Capture(m_freq_timer->stamp64(*m_ccr)); // m_freq_timer->CCR1;
+}
+
+bool FreqChannel::Capture(uint64_t stamp)
+{ // with the capture prescaler one capture covers 1 << m_psc periods, the count is the difference of
+    // the 64-bit stamps so a VCO which stopped for a counter wrap or longer only restarts the
+    // measurement, returns true when the prescaler changed
+    uint64_t count = stamp - m_stamp64;
+    m_stamp64 = stamp;
+    m_count_1 = m_count_0;
+    m_count_0 = (uint32_t)stamp;
+    if (count >= FREQ_MAXCOUNT)
+        m_count_step = false;
     if (m_count_step)
-    { // start measuring
-        m_count_1 = m_ccrdata;
+    {
+        m_ring[m_ringhead] = (uint32_t)count >> m_psc;
+        m_ringhead = (m_ringhead + 1) % FREQ_RING;
+        m_ringcount = m_ringcount < FREQ_RING ? m_ringcount + 1 : FREQ_RING;
+        return (Publish((uint32_t)count, 1 << m_psc)); // clears m_count_step when the prescaler changes
+    }
+    m_count_step = true; // the first capture is only the start of the next measurement
+    return (false);
+}
+
+FreqSample FreqChannel::Median(void)
+{ // a glitch moves the median at most one place, the confidence says how many periods agree with it
+    uint32_t ring[FREQ_RING], width, tolerance;
+    uint8_t count, agree = 0;
+    int8_t i, j;
+    FreqSample sample;
+    core_util_critical_section_enter();
+    count = m_ringcount;
+    memcpy(ring, m_ring, sizeof(ring));
+    core_util_critical_section_exit();
+    sample.width = 0, sample.confidence = 0;
+    if (!count)
+        return (sample);
+    for (i = 1; i < count; i++)
+    { // insertion sort of the few periods
+        width = ring[i];
+        for (j = i - 1; j >= 0 && ring[j] > width; j--)
+            ring[j + 1] = ring[j];
+        ring[j + 1] = width;
+    }
+    sample.width = count & 1 ? ring[count / 2] : (ring[count / 2 - 1] + ring[count / 2]) / 2;
+    tolerance = sample.width >> FREQ_AGREE;
+    for (i = 0; i < count; i++)
+        if ((ring[i] > sample.width ? ring[i] - sample.width : sample.width - ring[i]) <= tolerance)
+            agree++;
+    sample.confidence = (agree * 100) / count;
+    return (sample);
+}
+
+void FreqChannel::Clearring(void)
+{ // after a new output the ring would hold the periods of the old frequency for FREQ_RING captures
+    core_util_critical_section_enter();
+    m_ringhead = 0, m_ringcount = 0;
+    core_util_critical_section_exit();
+}
+
+void FreqChannel::Setdma(DMA_Stream_TypeDef *dma, uint8_t dmachannel)
+{ // circular, word sized, from the channel's CCR to m_stamps
+    m_dma = dma;
+    m_stampread = 0;
+    if (!m_dma)
+        return;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    m_dma->CR &= ~DMA_SxCR_EN;
+    while (m_dma->CR & DMA_SxCR_EN)
+        ;
+    m_dma->PAR = (uint32_t)(uintptr_t)m_ccr;
+    m_dma->M0AR = (uint32_t)(uintptr_t)m_stamps;
+    m_dma->NDTR = FREQ_STAMPS;
+    m_dma->FCR = 0; // direct mode
+    m_dma->CR = ((uint32_t)dmachannel << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL_0 | DMA_SxCR_MSIZE_1 |
+                DMA_SxCR_PSIZE_1 | DMA_SxCR_MINC | DMA_SxCR_CIRC;
+    m_dma->CR |= DMA_SxCR_EN;
+}
+
+bool FreqChannel::Getdma(void)
+{
+    return (m_dma != NULL);
+}
+
+uint16_t FreqChannel::Poll(void)
+{ // the DMA's write position is FREQ_STAMPS - NDTR, FREQ_STAMPS and FREQ_POLLRATE keep it from lapping
+    // m_stampread.  When Publish changes the prescaler it moves m_stampread past the timestamps captured
+    // with the old one, so the rest of the batch is dropped.  A poll late enough for the DMA to have
+    // lapped, when the flash stalled the interrupts, drops the batch and restarts the measurement.
+    uint16_t write, captures = 0;
+    uint64_t now;
+    uint32_t stamp;
+    if (!m_dma)
+        return (0);
+    write = (FREQ_STAMPS - m_dma->NDTR) & (FREQ_STAMPS - 1);
+    now = m_freq_timer->count64(); // every timestamp up to write was captured before now
+    if (m_width && now - m_polled > ((uint64_t)m_width << m_psc) * (FREQ_STAMPS / 2))
+    {
+        m_stampread = write;
         m_count_step = false;
-        if (m_count_1 > m_count_0)
-        { // if not > it means the counter overflowed so don't set width ... get it next time.
-            m_width = m_count_1 - m_count_0;
-            m_freq_sample.release();
-            // release the adjust semaphore only if not adjusted
-            if (!m_dac->Getoffsetvals().adjusted)
-                m_dac->GetVCO()->Getvcoadjsem()->release();
-        }
     }
-    else
-    { // stop
-        //m_freq_timer->DIER &= ~TIM_DIER_CC1IE;  // disable IC1 interrupt
-        m_count_0 = m_ccrdata;
-        m_count_step = true;
-        if (m_count_0 > m_count_1)
-        { // if not > it means the counter overflowed so don't set width ... get it next time.
-            m_width = m_count_0 - m_count_1;
-            m_freq_sample.release();
-            // release the adjust semaphore only if not adjusted
-            if (!m_dac->Getoffsetvals().adjusted)
-                m_dac->GetVCO()->Getvcoadjsem()->release();
-        }
+    m_polled = now;
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr((uint32_t *)m_stamps, sizeof(m_stamps)); // the DMA bypasses the D-cache
+#endif
+    while (m_stampread != write)
+    {
+        stamp = m_stamps[m_stampread];
+        m_stampread = (m_stampread + 1) & (FREQ_STAMPS - 1);
+        captures++;
+        if (Capture(now - (uint32_t)((uint32_t)now - stamp))) // less than a counter wrap old
+            break;
     }
+    return (captures);
+}
+
+uint32_t FreqChannel::Getjitter(void)
+{
+    return m_jitter;
+}
+
+static uint32_t freqpollus, freqpollmax, freqpollcaptures, freqpollmostcaptures;
+static char freqpollbuffer[120];
+
+void FreqPoll(void)
+{ // the time of one poll is the interrupt budget of all the frequency channels
+    uint32_t start = us_ticker_read(), captures = 0;
+    for (int i = 0; i < NUMBERFREQS; i++)
+        if (FREQS[i] && FREQS[i]->Getdma())
+            captures += FREQS[i]->Poll();
+    freqpollus = us_ticker_read() - start;
+    freqpollcaptures = captures;
+    if (freqpollus > freqpollmax)
+        freqpollmax = freqpollus;
+    if (captures > freqpollmostcaptures)
+        freqpollmostcaptures = captures;
+}
+
+char *FreqPollprint(void)
+{ // the load is the percent of the CPU used by the slowest poll
+    uint32_t load = freqpollmax * FREQ_POLLRATE / 100; // 1/100 percent, 110 us per 10 ms poll is 1.10%
+    sprintf(freqpollbuffer, "FreqPoll captures %lu most %lu us %lu max %lu load %lu.%02lu%%\r\n",
+            (long unsigned int)freqpollcaptures,
+            (long unsigned int)freqpollmostcaptures,
+            (long unsigned int)freqpollus,
+            (long unsigned int)freqpollmax,
+            (long unsigned int)load / 100,
+            (long unsigned int)load % 100);
+    return freqpollbuffer;
 }
@@ -10,9 +10,24 @@ class FreqTimer;
 extern FreqTimer *freqtimer0;
 extern FreqTimer *freqtimer1;
 
-#define NUMBERFREQS 6
+#define NUMBERFREQS 8
+#define FREQ_NOTIFYRATE 200         // Hz, widths are averaged and published at most this often
+#define FREQ_MAXCAPTURE 2000        // Hz, the capture prescaler keeps a channel's interrupts under this
+#define FREQ_MAXPSC 3               // ICxPSC, a capture every 8 edges at most
+#define FREQ_STAMPS 256             // DMA capture timestamps per channel, a power of 2
+#define FREQ_POLLRATE 100           // Hz, FreqPoll reads the timestamps before the DMA wraps, below 25.6 kHz of captures
+#define FREQ_RING 8                 // recent periods kept for Median
+#define FREQ_AGREE 8                // a period agrees with the median when within median >> FREQ_AGREE
+#define FREQ_MINCONFIDENCE 75       // percent of the recent periods which must agree with the median
+#define FREQ_MAXCOUNT 0x80000000ULL // timer counts, a longer gap between captures restarts the measurement
+
+struct FreqSample
+{
+    uint32_t width;     // median of the recent periods, 0 when there are none
+    uint8_t confidence; // percent of the recent periods within width >> FREQ_AGREE of the median
+};
 typedef FreqChannel *FREQPtr;
-extern FREQPtr *FREQS;
+extern FREQPtr FREQS[NUMBERFREQS];
 
 class FreqTimer
 {
@@ -22,12 +37,12 @@ class FreqTimer
     uint32_t m_prescaler;
     IRQn_Type m_IRQn;
     uint8_t m_tnum;
-    uint16_t m_overflow;
+    volatile uint32_t m_overflow;
     uint8_t m_count_step;
     uint32_t m_count_start;
     uint32_t m_count_stop;
     uint32_t m_width;
-    char m_buffer[80];
+    char m_buffer[100];
     FreqChannel *m_channels[4];
 
   public:
@@ -35,9 +50,13 @@ class FreqTimer
     FreqTimer(typeof(TIM2) ftimer, uint32_t timer_enable, IRQn_Type timer_IRQn, uint32_t irq_func, uint32_t timer_prescaler, uint8_t ftnum);
     void SetChannel(FreqChannel *freqchannel, uint8_t chnum);
     void start_action(bool s1, bool s2, bool s3, bool s4);
+    void start_dma(bool s1, bool s2, bool s3, bool s4); // captures go to DMA, no capture interrupts
     char *print(void);
     uint32_t timercount(void);
-    uint16_t overflow(void);
+    void SetPrescaler(uint8_t chnum, uint8_t psc);
+    uint32_t overflow(void);
+    uint64_t count64(void);         // the counter extended to 64 bits with m_overflow
+    uint64_t stamp64(uint32_t ccr); // a capture less than a counter wrap old extended to 64 bits
     void irq_ic_timer(void);
 };
 
@@ -50,27 +69,57 @@ class FreqChannel
     uint32_t m_enable;
     uint8_t m_port;
     uint8_t m_chnum;
-    uint32_t m_ccrdata;
     volatile uint32_t *m_ccr;
     bool m_count_step, m_count_sampled;
     uint32_t m_count_0, m_count_1, m_width;
-    char *m_buffer;
+    volatile uint32_t m_samples; // counts the widths published, Autotune polls it instead of waiting
+    volatile uint32_t m_periods, m_wakeups; // periods captured and VCOAdj0 wakeups
+    uint32_t m_interval;                    // timer counts to average before publishing a width
+    uint32_t m_accum;
+    uint16_t m_accumcnt;
+    char m_buffer[200]; // vars' counters at full width
     Semaphore m_freq_sample;
     int32_t m_semaphore_id;
+    uint8_t m_psc; // ICxPSC of the channel
+    uint32_t m_mincount, m_maxcount, m_jitter; // shortest and longest capture since the last publish
+    uint32_t m_stamps[FREQ_STAMPS] __attribute__((aligned(32))); // circular DMA buffer, cache line aligned
+    DMA_Stream_TypeDef *m_dma;
+    uint16_t m_stampread;
+    uint64_t m_polled; // FreqTimer::count64 of the last Poll
+    uint32_t m_ring[FREQ_RING]; // periods of the recent captures
+    uint8_t m_ringhead, m_ringcount;
+    uint64_t m_stamp64; // the last capture extended to 64 bits
+    bool Capture(uint64_t stamp);                  // true when the prescaler changed
+    bool Publish(uint32_t count, uint8_t periods); // true when the prescaler changed
 
   public:
     // Parameterized Constructor
+    FreqChannel(void); // for the statically placed board arrays, Init before use
     FreqChannel(typeof(GPIOA) fgpio, FreqTimer *ftimer, uint32_t fenable, uint8_t fport, uint8_t fchnum, volatile uint32_t *fccr, uint32_t af);
+    void Init(typeof(GPIOA) fgpio, FreqTimer *ftimer, uint32_t fenable, uint8_t fport, uint8_t fchnum, volatile uint32_t *fccr, uint32_t af);
     char *vars(void);
     void irq_freq(void);
+    void Setdma(DMA_Stream_TypeDef *dma, uint8_t dmachannel); // stream the captures into m_stamps
+    bool Getdma(void);
+    uint16_t Poll(void); // take the timestamps the DMA wrote since the last Poll
+    uint32_t Getjitter(void);
     void SetDAC(LTC2668 *dac);
     LTC2668 *GetDAC(void);
     uint32_t GetWidth(void);
     uint32_t GetSampledWidth(void);
+    uint32_t Getsamples(void);
+    void Setnotifyrate(uint32_t rate); // Hz, 0 publishes every period
+    uint32_t Getperiods(void);
+    uint32_t Getwakeups(void);
     uint32_t Freq16(void);
-    uint32_t SampledFreq16(void);
+    uint32_t SampledFreq16(uint8_t *confidence = NULL); // waits for the next width, returns the median
+    FreqSample Median(void);
+    void Clearring(void); // Median only uses the periods captured from now on
     float Freqf(void);
     float SampledFreqf(void);
 };
 
+void FreqPoll(void);       // Poll every DMA channel, called FREQ_POLLRATE times a second
+char *FreqPollprint(void); // captures and time of the last and slowest polls
+
 #endif
@@ -4,7 +4,9 @@
 #include "freq.h"
 #include "vco.h"
 #include "dac.h"
+#include "dacbus.h"
 #include "envelope.h"
+#include "envbank.h"
 #include "functimer.h"
 
 FuncTimer::FuncTimer(typeof(TIM2) ftimer, uint32_t timer_enable,
@@ -38,6 +40,9 @@ FuncTimer::FuncTimer(typeof(TIM2) ftimer, uint32_t timer_enable,
     m_overflow = 0;
     m_s1 = 0, m_s2 = 0, m_s3 = 0, m_s4 = 0;
     m_envcnt = 0, m_adsrcnt = 0, m_daccnt = 0;
+    m_cycles = 0, m_maxcycles = 0;
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // cycle counter for timing the ISR
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
     NVIC_SetVector(m_IRQn, irq_func);
     NVIC_ClearPendingIRQ(m_IRQn);
     NVIC_EnableIRQ(m_IRQn);
@@ -45,9 +50,11 @@ FuncTimer::FuncTimer(typeof(TIM2) ftimer, uint32_t timer_enable,
 
 void FuncTimer::Clear(void)
 {
-    std::vector<Envelope *>(m_envelopes).swap(m_envelopes); // clear and shrink vector
-    std::vector<Adsr *>(m_adsrs).swap(m_adsrs);             // clear and shrink vector
-    std::vector<LTC2668 *>(m_dacs).swap(m_dacs);            // clear and shrink vector
+    std::vector<Envelope *>().swap(m_envelopes); // clear and shrink vector
+    std::vector<Adsr *>().swap(m_adsrs);         // clear and shrink vector
+    std::vector<LTC2668 *>().swap(m_dacs);       // clear and shrink vector
+    std::vector<ToggleTick>().swap(m_toggles);   // clear and shrink vector
+    m_bank = NULL;
 }
 
 void FuncTimer::Add(Envelope *env)
@@ -65,6 +72,20 @@ void FuncTimer::Add(LTC2668 *dac)
     m_dacs.push_back(dac);
 }
 
+void FuncTimer::Add(EnvBank *bank)
+{
+    m_bank = bank;
+}
+
+void FuncTimer::AddToggle(DACBus *bus, uint16_t ticks)
+{
+    ToggleTick t;
+    t.bus = bus;
+    t.ticks = !ticks ? 1 : ticks;
+    t.cnt = 0;
+    m_toggles.push_back(t);
+}
+
 void FuncTimer::SetReload(int32_t auto_reload)
 {
     m_auto_reload = auto_reload;
@@ -93,19 +114,26 @@ void FuncTimer::Stop()
     __enable_irq();
 }
 
+bool FuncTimer::Running()
+{
+    return ((m_timer->DIER & TIM_DIER_UIE) != 0);
+}
+
 char *FuncTimer::print()
 {
-    sprintf(m_buffer, "Timer %d %12lu %lx %lx %lx %lx %lx %lx %lx %d %d %d %d %d\r\n",
+    sprintf(m_buffer, "Timer %d %12lu %lx %lx %lx %lx %lx %lx %lx %d %d %d %d %d cycles %lu max %lu\r\n",
             m_tnum,
-            m_timer->CNT,
+            (long unsigned int)m_timer->CNT,
             (long unsigned int)&m_timer->CNT,
-            m_timer->ARR,
-            m_timer->PSC,
-            m_timer->CR1,
-            m_timer->SMCR,
-            m_timer->SR,
-            m_timer->DIER,
-            m_overflow, m_s1, m_s2, m_s3, m_s4);
+            (long unsigned int)m_timer->ARR,
+            (long unsigned int)m_timer->PSC,
+            (long unsigned int)m_timer->CR1,
+            (long unsigned int)m_timer->SMCR,
+            (long unsigned int)m_timer->SR,
+            (long unsigned int)m_timer->DIER,
+            m_overflow, m_s1, m_s2, m_s3, m_s4,
+            (long unsigned int)m_cycles,
+            (long unsigned int)m_maxcycles);
     return m_buffer;
 }
 
@@ -123,8 +151,12 @@ void FuncTimer::irq_ic_timer(void)
 {
     if (m_timer->SR & TIM_SR_UIF)
     { // counter overflow
+        uint32_t start = DWT->CYCCNT;
         m_timer->SR &= ~TIM_SR_UIF;
         ++m_overflow;
+        DACBusHold(); // DAC writes during the tick are only queued
+        if (m_bank && m_bank->Next())
+            m_bank->Emit();
         for (m_envcnt = 0; m_envcnt < m_envelopes.size(); m_envcnt++)
         {
             if (!m_envelopes[m_envcnt]->m_stopflag)
@@ -139,5 +171,17 @@ void FuncTimer::irq_ic_timer(void)
         {
             m_dacs[m_daccnt]->Next();
         }
+        for (m_daccnt = 0; m_daccnt < m_toggles.size(); m_daccnt++)
+        {
+            if (++m_toggles[m_daccnt].cnt >= m_toggles[m_daccnt].ticks)
+            { // one short command (or the TGP pin) switches every toggled DAC on the chip
+                m_toggles[m_daccnt].cnt = 0;
+                m_toggles[m_daccnt].bus->Toggle();
+            }
+        }
+        DACBusFlush(); // one burst per SPI channel
+        m_cycles = DWT->CYCCNT - start;
+        if (m_cycles > m_maxcycles)
+            m_maxcycles = m_cycles;
     }
 }
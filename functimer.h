@@ -6,6 +6,15 @@
 #include "envelope.h"
 
 class FuncTimer;
+class DACBus;
+class EnvBank;
+
+struct ToggleTick
+{
+    DACBus *bus;
+    uint16_t ticks; // toggle every 'ticks' timer ticks
+    uint16_t cnt;
+};
 
 extern FuncTimer *functimer0;
 extern FuncTimer *functimer1;
@@ -20,10 +29,13 @@ class FuncTimer
     IRQn_Type m_IRQn;
     uint8_t m_tnum;
     uint16_t m_overflow, m_s1, m_s2, m_s3, m_s4, m_envcnt, m_adsrcnt, m_daccnt;
-    char m_buffer[80];
+    uint32_t m_cycles, m_maxcycles; // CPU cycles spent in the last and the longest tick
+    char m_buffer[200]; // print's registers and counters at full width
     std::vector<Envelope *> m_envelopes; // list of Envelopes
     std::vector<Adsr *> m_adsrs;         // list of Adsrs
     std::vector<LTC2668 *> m_dacs;       // list of DACs
+    std::vector<ToggleTick> m_toggles;   // list of DAC chips with toggled channels
+    EnvBank *m_bank;                     // envelopes run from arrays, NULL when there is none
   public:
     // Parameterized Constructor
     FuncTimer(typeof(TIM2) ftimer, uint32_t timer_enable,
@@ -33,10 +45,13 @@ class FuncTimer
     void Add(Envelope *env);
     void Add(Adsr *adsr);
     void Add(LTC2668 *dac);
+    void Add(EnvBank *bank);
+    void AddToggle(DACBus *bus, uint16_t ticks); // square waves, gates and trills without code writes
     void SetReload(int32_t auto_reload);
     void IncReload(int32_t inc);
     void Start(void);
     void Stop(void);
+    bool Running(void);
     char *print(void);
     uint32_t timercount(void);
     uint16_t overflow(void);
@@ -0,0 +1,938 @@
+// host.cpp ... the simulated board behind host/mbed.h and host/rtos.h
+#include <pthread.h>
+#include <stdarg.h>
+#include <vector>
+#include "mbed.h"
+#include "rtos.h"
+#include "main.h"
+#include "board.h"
+#include "host.h"
+
+TIM_TypeDef host_tim[4];
+GPIO_TypeDef host_gpio[7];
+RCC_TypeDef host_rcc;
+DMA_Stream_TypeDef host_dma1[8];
+DWT_Type host_dwt;
+CoreDebug_Type host_coredebug;
+
+int hostchecks = 0, hostfailures = 0;
+
+struct HostTransfer
+{
+    uint64_t time; // ns when the frame is off the wire
+    SPI *spi;
+    char tx[4];
+    int length;
+    char *rx;
+    event_callback_t callback;
+    int event;
+};
+
+extern SPI spi5, spi4, spi1, spi6; // board.cpp, the DACBuses 0 to 3
+
+static pthread_mutex_t hostlock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP; // the interrupt mask
+static __thread int hostdepth;  // critical section nesting of the thread
+static __thread bool hostisr;   // running a pended interrupt
+static uint64_t hostnow;        // ns
+static uint64_t hostworld;      // ns, the VCOs have made their edges until here
+static uint64_t hostspitime;    // ns, the completion time while an SPI callback runs, otherwise 0
+static uint32_t hostvectors[HOST_IRQS];
+static uint32_t hostpended;     // bit per IRQn_Type
+static uint32_t hostirqs[HOST_IRQS];
+static uint64_t hostirqcpu[HOST_IRQS]; // host ns in each vector
+static std::vector<HostTransfer> hosttransfers;
+static std::vector<Ticker *> hosttickers;
+static int64_t hostcountbase[2]; // TIM2 and TIM5 counts at time 0
+static uint32_t hostwraps[2];    // high word of the counts at the last update
+static uint64_t hostupdate[HOST_IRQS]; // ns of the next update of TIM3 and TIM7, 0 when stopped
+static HostVCO hostvcos[NUMBERVCOS];
+static bool hoststarted[NUMBERVCOS];
+static uint32_t hostedges[NUMBERFREQS]; // edges seen by each input's capture prescaler
+static uint32_t hostdmasize[8];         // NDTR of each DMA stream when it was enabled
+static uint32_t hostrandom = 12345;
+static const char *hostflashfile = "host_flash.bin";
+static FILE *hostflash;
+static uint32_t hosterases;
+
+static struct HostDefaults
+{
+    HostDefaults(void)
+    {
+        for (int i = 0; i < NUMBERVCOS; i++)
+        {
+            memset(&hostvcos[i], 0, sizeof(HostVCO));
+            hostvcos[i].running = true;
+            hostvcos[i].settle = 0.001;
+        }
+    }
+} hostdefaults;
+
+static void HostService(void);
+
+static uint64_t HostTime(void)
+{
+    return (hostspitime ? hostspitime : hostnow);
+}
+
+static double HostRandom(void)
+{ // 0 to 1, the same sequence every run
+    hostrandom = hostrandom * 1103515245 + 12345;
+    return ((hostrandom >> 8) / 16777216.0);
+}
+
+HostCycles::operator uint32_t() const
+{
+    return ((uint32_t)(HostTime() * HOST_CPUCLK / 1000));
+}
+
+uint64_t HostNow(void)
+{
+    return (hostnow);
+}
+
+uint64_t HostCPU(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+int HostPrintf(const char *format, ...)
+{ // the firmware's printf, appended to HOST_LOG
+    static FILE *log;
+    va_list args;
+    int length;
+    if (!log && !(log = fopen(HOST_LOG, "a")))
+        return (0);
+    va_start(args, format);
+    length = vfprintf(log, format, args);
+    va_end(args);
+    fflush(log);
+    return (length);
+}
+
+// the world
+
+double HostError(int8_t voice, uint16_t code)
+{
+    return (HostError(voice, code, hostnow * 1e-9));
+}
+
+double HostError(int8_t voice, uint16_t code, double seconds)
+{
+    HostVCO *vco = &hostvcos[voice];
+    double tritone = code / 3264.0;
+    return (vco->offset + vco->drift * seconds + vco->scale * (tritone - 11) +
+            vco->rolloff * pow(2.0, (tritone - 18) / 2.0));
+}
+
+static void HostEdge(int8_t voice, double seconds)
+{ // the voice's input captures the edge if its prescaler lets it through
+    int8_t freq = VOICEBOARD[voice].freq, channel = freq % 4, timer = FREQBOARD[freq].timer;
+    TIM_TypeDef *tim = timer ? TIM5 : TIM2;
+    uint32_t ccmr = channel < 2 ? tim->CCMR1 : tim->CCMR2;
+    uint8_t psc = (ccmr >> ((channel & 1) ? 10 : 2)) & 3;
+    DMA_Stream_TypeDef *dma = FREQBOARD[freq].dma;
+    uint32_t stamp, *buffer;
+    int8_t stream = dma - host_dma1;
+    if (!(tim->CR1 & TIM_CR1_CEN) || !(tim->CCER & (TIM_CCER_CC1E << (4 * channel))))
+        return;
+    if (++hostedges[freq] & ((1 << psc) - 1))
+        return;
+    if (hostvcos[voice].jitter)
+        seconds += hostvcos[voice].jitter * (HostRandom() * 2 - 1);
+    stamp = (uint32_t)(hostcountbase[timer] + (int64_t)(seconds * HOST_TIMERCLK * 1e6));
+    *FREQBOARD[freq].ccr = stamp;
+    if (tim->DIER & (TIM_DIER_CC1DE << channel))
+    { // the DMA request, the stream writes the CCR to its circular buffer
+        if (!(dma->CR & DMA_SxCR_EN))
+            return;
+        if (!hostdmasize[stream])
+            hostdmasize[stream] = dma->NDTR;
+        buffer = (uint32_t *)(uintptr_t)dma->M0AR;
+        buffer[hostdmasize[stream] - dma->NDTR] = stamp;
+        if (!--dma->NDTR)
+            dma->NDTR = hostdmasize[stream];
+        return;
+    }
+    tim->SR |= TIM_SR_CC1IF << channel;
+    if (tim->DIER & (TIM_DIER_CC1IE << channel))
+        hostpended |= 1 << (timer ? TIM5_IRQn : TIM2_IRQn);
+}
+
+static void HostWorld(uint64_t start, uint64_t ns)
+{ // every VCO's frequency is constant for the slice, then its pitch moves toward the code's
+    double seconds = start * 1e-9, slice = ns * 1e-9, target, freq, remain, at, to;
+    HostVCO *vco;
+    uint16_t code;
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+    {
+        vco = &hostvcos[voice];
+        code = HostCode(VOICEBOARD[voice].dac);
+        target = code - HostError(voice, code, seconds);
+        if (!hoststarted[voice])
+            vco->pitch = target, hoststarted[voice] = true;
+        if (vco->running)
+        {
+            freq = VOICEBOARD[voice].lowfreq * pow(2.0, vco->pitch / VOICEBOARD[voice].dins_per_volt);
+            remain = slice, at = seconds;
+            while (vco->phase + freq * remain >= 1.0)
+            {
+                to = (1.0 - vco->phase) / freq;
+                at += to, remain -= to;
+                vco->phase = 0;
+                vco->periods++;
+                if (vco->glitch && !(vco->periods % vco->glitch))
+                    vco->phase = 0.5; // the next period is half as long
+                HostEdge(voice, at);
+            }
+            vco->phase += freq * remain;
+        }
+        vco->pitch += (target - vco->pitch) * (vco->settle > 0 ? 1.0 - exp(-slice / vco->settle) : 1.0);
+    }
+}
+
+static void HostTimers(void)
+{ // counter wraps, FuncTimer updates and Tickers which are due are pended
+    TIM_TypeDef *tim;
+    IRQn_Type irq;
+    uint64_t count, period;
+    for (int8_t timer = 0; timer < 2; timer++)
+    {
+        tim = timer ? TIM5 : TIM2;
+        irq = timer ? TIM5_IRQn : TIM2_IRQn;
+        count = hostcountbase[timer] + (int64_t)(hostnow * HOST_TIMERCLK / 1000);
+        tim->CNT = (uint32_t)count;
+        if ((uint32_t)(count >> 32) != hostwraps[timer])
+        {
+            hostwraps[timer] = count >> 32;
+            tim->SR |= TIM_SR_UIF;
+            if (tim->DIER & TIM_DIER_UIE)
+                hostpended |= 1 << irq;
+        }
+    }
+    for (int8_t i = 0; i < 2; i++)
+    {
+        irq = i ? TIM7_IRQn : TIM3_IRQn;
+        tim = &host_tim[irq];
+        period = ((uint64_t)tim->PSC + 1) * ((uint64_t)tim->ARR + 1) * 1000 / HOST_TIMERCLK;
+        if (!(tim->CR1 & TIM_CR1_CEN) || !(tim->DIER & TIM_DIER_UIE) || !period)
+        {
+            hostupdate[irq] = 0;
+            continue;
+        }
+        if (!hostupdate[irq])
+            hostupdate[irq] = hostnow + period;
+        if (hostnow < hostupdate[irq])
+            continue;
+        while (hostupdate[irq] <= hostnow)
+            hostupdate[irq] += period;
+        tim->SR |= TIM_SR_UIF;
+        hostpended |= 1 << irq;
+    }
+    for (size_t i = 0; i < hosttickers.size(); i++)
+    {
+        Ticker *ticker = hosttickers[i];
+        if (!ticker->m_period || hostnow < ticker->m_next)
+            continue;
+        while (ticker->m_next <= hostnow)
+            ticker->m_next += ticker->m_period;
+        ticker->m_pending = true;
+    }
+}
+
+static void HostCatchup(uint64_t end)
+{ // the VCOs run until end without any interrupt being taken
+    uint64_t step;
+    while (hostworld < end)
+    {
+        step = end - hostworld < HOST_SLICE ? end - hostworld : HOST_SLICE;
+        HostWorld(hostworld, step);
+        hostworld += step;
+    }
+    if (hostnow < end)
+        hostnow = end;
+    HostTimers();
+}
+
+void HostRun(uint64_t ns)
+{
+    uint64_t end = hostnow + ns, step;
+    pthread_mutex_lock(&hostlock);
+    HostCatchup(hostnow); // a stall or blocking SPI writes moved the time on
+    if (!hostdepth && !hostisr)
+        HostService();
+    while (hostworld < end)
+    {
+        step = end - hostworld < HOST_SLICE ? end - hostworld : HOST_SLICE;
+        HostWorld(hostworld, step);
+        hostworld += step;
+        if (hostnow < hostworld)
+            hostnow = hostworld;
+        HostTimers();
+        if (!hostdepth && !hostisr)
+            HostService();
+    }
+    pthread_mutex_unlock(&hostlock);
+}
+
+void HostStall(uint64_t ns)
+{
+    pthread_mutex_lock(&hostlock);
+    HostCatchup(HostTime() + ns);
+    pthread_mutex_unlock(&hostlock);
+}
+
+void HostSetcount(int8_t timer, uint64_t count)
+{ // the 64-bit count, a jump over a wrap is one update event at the next slice
+    pthread_mutex_lock(&hostlock);
+    hostcountbase[timer] = (int64_t)count - (int64_t)(hostnow * HOST_TIMERCLK / 1000);
+    (timer ? TIM5 : TIM2)->CNT = (uint32_t)count;
+    pthread_mutex_unlock(&hostlock);
+}
+
+uint64_t HostGetcount(int8_t timer)
+{
+    return (hostcountbase[timer] + (int64_t)(hostnow * HOST_TIMERCLK / 1000));
+}
+
+HostVCO *HostGetVCO(int8_t voice)
+{
+    return (&hostvcos[voice]);
+}
+
+SPI *HostGetSPI(int8_t bus)
+{
+    SPI *spis[NUMBERDACBUSES] = {&spi5, &spi4, &spi1, &spi6};
+    return (spis[bus & 3]);
+}
+
+uint16_t HostCode(int8_t dac)
+{
+    return (HostGetSPI(DACBOARD[dac].bus)->m_chip.Code(DACBOARD[dac].channel));
+}
+
+// interrupts
+
+static void HostService(void)
+{ // with no critical section or interrupt active, the pended interrupts run one after another, the
+    // SPI completions in the order they come off the wire.  Nothing else runs while a frame is on the
+    // wire, so the time moves on to its completion.
+    size_t first;
+    HostTransfer transfer;
+    pthread_mutex_lock(&hostlock);
+    while (true)
+    {
+        if (!hosttransfers.empty())
+        {
+            first = 0;
+            for (size_t i = 1; i < hosttransfers.size(); i++)
+                if (hosttransfers[i].time < hosttransfers[first].time)
+                    first = i;
+            transfer = hosttransfers[first];
+            hosttransfers.erase(hosttransfers.begin() + first);
+            if (transfer.time > hostnow)
+                HostCatchup(transfer.time); // the thread waits for the frame like the firmware's spin loops
+            hostisr = true, hostspitime = transfer.time;
+            if (transfer.spi->m_fails)
+            { // the chip never sees the frame
+                transfer.spi->m_fails--;
+                transfer.callback(SPI_EVENT_ERROR & transfer.event); // the event that happened, not the mask
+                hostisr = false, hostspitime = 0;
+                continue;
+            }
+            if (transfer.rx)
+                memcpy(transfer.rx, transfer.spi->m_chip.echo, transfer.length < 3 ? transfer.length : 3);
+            if (transfer.length == 3)
+                transfer.spi->m_chip.Frame(transfer.tx);
+            transfer.callback(SPI_EVENT_COMPLETE & transfer.event);
+            hostisr = false, hostspitime = 0;
+            continue;
+        }
+        if (hostpended)
+        {
+            int irq = __builtin_ctz(hostpended);
+            hostpended &= ~(1 << irq);
+            if (hostvectors[irq])
+            {
+                uint64_t cpu = HostCPU();
+                hostisr = true;
+                ((void (*)(void))(uintptr_t)hostvectors[irq])();
+                hostisr = false;
+                hostirqs[irq]++;
+                hostirqcpu[irq] += HostCPU() - cpu;
+            }
+            continue;
+        }
+        size_t i;
+        for (i = 0; i < hosttickers.size() && !hosttickers[i]->m_pending; i++)
+            ;
+        if (i == hosttickers.size())
+            break;
+        hosttickers[i]->m_pending = false;
+        hostisr = true;
+        hosttickers[i]->m_callback();
+        hostisr = false;
+    }
+    pthread_mutex_unlock(&hostlock);
+}
+
+void HostISR(Callback<void()> isr)
+{
+    pthread_mutex_lock(&hostlock);
+    hostisr = true;
+    isr();
+    hostisr = false;
+    if (!hostdepth)
+        HostService();
+    pthread_mutex_unlock(&hostlock);
+}
+
+uint32_t HostIRQs(IRQn_Type irq, uint64_t *cpu)
+{
+    if (cpu)
+        *cpu = hostirqcpu[irq];
+    return (hostirqs[irq]);
+}
+
+void NVIC_SetVector(IRQn_Type irq, uint32_t vector)
+{
+    hostvectors[irq] = vector;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+    hostpended &= ~(1 << irq);
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+}
+
+void core_util_critical_section_enter(void)
+{
+    pthread_mutex_lock(&hostlock);
+    hostdepth++;
+}
+
+void core_util_critical_section_exit(void)
+{
+    if (hostdepth == 1 && !hostisr)
+        HostService(); // the pended interrupts are taken when the interrupts are enabled again
+    hostdepth--;
+    pthread_mutex_unlock(&hostlock);
+}
+
+bool core_util_is_isr_active(void)
+{
+    return (hostisr);
+}
+
+void __disable_irq(void)
+{
+    core_util_critical_section_enter();
+}
+
+void __enable_irq(void)
+{
+    core_util_critical_section_exit();
+}
+
+uint32_t __get_IPSR(void)
+{
+    return (hostisr ? 16 : 0);
+}
+
+void SCB_InvalidateDCache_by_Addr(uint32_t *addr, int32_t size)
+{
+}
+
+// time
+
+uint32_t us_ticker_read(void)
+{
+    return ((uint32_t)(HostTime() / 1000));
+}
+
+void wait(float s)
+{
+    HostRun((uint64_t)(s * 1e9));
+}
+
+void wait_ms(int ms)
+{
+    HostRun((uint64_t)ms * 1000000);
+}
+
+void wait_us(int us)
+{
+    HostRun((uint64_t)us * 1000);
+}
+
+Timer::Timer(void)
+{
+    m_start = 0, m_total = 0, m_running = false;
+}
+
+void Timer::start(void)
+{
+    if (!m_running)
+        m_start = HostTime(), m_running = true;
+}
+
+void Timer::stop(void)
+{
+    if (m_running)
+        m_total += HostTime() - m_start, m_running = false;
+}
+
+void Timer::reset(void)
+{
+    m_start = HostTime(), m_total = 0;
+}
+
+int Timer::read_us(void)
+{
+    return ((int)((m_total + (m_running ? HostTime() - m_start : 0)) / 1000));
+}
+
+int Timer::read_ms(void)
+{
+    return (read_us() / 1000);
+}
+
+float Timer::read(void)
+{
+    return (read_us() / 1e6f);
+}
+
+Ticker::Ticker(void)
+{
+    m_period = 0, m_next = 0, m_pending = false;
+    hosttickers.push_back(this);
+}
+
+Ticker::~Ticker(void)
+{
+    for (size_t i = 0; i < hosttickers.size(); i++)
+        if (hosttickers[i] == this)
+            hosttickers.erase(hosttickers.begin() + i);
+}
+
+void Ticker::attach_us(Callback<void()> callback, uint32_t us)
+{
+    core_util_critical_section_enter();
+    m_callback = callback;
+    m_period = (uint64_t)us * 1000;
+    m_next = hostnow + m_period;
+    m_pending = false;
+    core_util_critical_section_exit();
+}
+
+void Ticker::attach(Callback<void()> callback, float s)
+{
+    attach_us(callback, (uint32_t)(s * 1e6f));
+}
+
+void Ticker::detach(void)
+{
+    core_util_critical_section_enter();
+    m_period = 0, m_pending = false;
+    core_util_critical_section_exit();
+}
+
+// rtos
+
+Thread::Thread(void)
+{
+    m_started = false;
+}
+
+osStatus Thread::start(Callback<void()> task)
+{
+    m_task = task, m_started = true;
+    return (osOK);
+}
+
+osStatus Thread::join(void)
+{
+    return (osOK);
+}
+
+osStatus Thread::terminate(void)
+{
+    m_started = false;
+    return (osOK);
+}
+
+bool Thread::Started(void)
+{
+    return (m_started);
+}
+
+osStatus Thread::wait(uint32_t ms)
+{
+    HostRun((uint64_t)ms * 1000000);
+    return (osOK);
+}
+
+osStatus Thread::yield(void)
+{
+    return (osOK);
+}
+
+Semaphore::Semaphore(int32_t count)
+{
+    m_count = count;
+}
+
+int32_t Semaphore::wait(uint32_t ms)
+{ // osWaitForever gives up after a minute of simulated time
+    uint64_t end = hostnow + (ms == osWaitForever ? 60000000000ULL : (uint64_t)ms * 1000000);
+    int32_t count = 0;
+    while (m_count <= 0 && hostnow < end)
+        HostRun(HOST_SLICE);
+    core_util_critical_section_enter();
+    if (m_count > 0)
+        count = m_count--;
+    core_util_critical_section_exit();
+    return (count);
+}
+
+osStatus Semaphore::release(void)
+{
+    core_util_critical_section_enter();
+    m_count++;
+    core_util_critical_section_exit();
+    return (osOK);
+}
+
+osStatus Mutex::lock(uint32_t ms)
+{
+    return (osOK);
+}
+
+osStatus Mutex::unlock(void)
+{
+    return (osOK);
+}
+
+// SPI and the LTC2668
+
+void HostChip::Frame(const char *frame)
+{ // LTC2668 commands, the channel's toggle select bit picks input register A or B
+    uint8_t command = (uint8_t)frame[0] >> 4, n = frame[0] & 0x0f;
+    uint16_t data = ((uint8_t)frame[1] << 8) | (uint8_t)frame[2];
+    frames++;
+    memcpy(echo, frame, 3);
+    for (int8_t channel = 0; channel < 16; channel++)
+    {
+        bool one = channel == n, write, update;
+        switch (command)
+        {
+        case 0x0: // write code n
+            write = one, update = false;
+            break;
+        case 0x1: // update n
+            write = false, update = one;
+            break;
+        case 0x2: // write code n, update all
+            write = one, update = true;
+            break;
+        case 0x3: // write code n, update n
+            write = one, update = one;
+            break;
+        case 0x6: // span n
+            if (one)
+                span[channel] = data & 7;
+            write = false, update = false;
+            break;
+        case 0x8: // write code all
+            write = true, update = false;
+            break;
+        case 0x9: // update all
+            write = false, update = true;
+            break;
+        case 0xa: // write code all, update all
+            write = true, update = true;
+            break;
+        case 0xe: // span all
+            span[channel] = data & 7;
+            write = false, update = false;
+            break;
+        default: // power down, config, mux, toggle and no operation
+            write = false, update = false;
+            break;
+        }
+        if (write)
+            input[(toggle >> channel) & 1][channel] = data;
+        if (update)
+            dac[0][channel] = input[0][channel], dac[1][channel] = input[1][channel];
+    }
+    if (command == 0xc)
+        toggle = data;
+    else if (command == 0xd)
+        tgb = data & 1;
+}
+
+uint16_t HostChip::Code(int8_t channel)
+{
+    return (dac[((toggle >> channel) & 1) && tgb][channel]);
+}
+
+SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel)
+{
+    memset(&m_chip, 0, sizeof(m_chip));
+    m_hz = 1000000, m_transfers = 0, m_writes = 0, m_free = 0, m_fails = 0;
+}
+
+void SPI::format(int bits, int mode)
+{
+}
+
+void SPI::frequency(int hz)
+{
+    m_hz = hz;
+}
+
+uint64_t SPI::Wiretime(int bytes)
+{
+    return ((uint64_t)bytes * 8 * 1000000000ULL / m_hz);
+}
+
+int SPI::write(int value)
+{ // the CPU waits for the byte
+    m_writes++;
+    HostStall(Wiretime(1));
+    return (0);
+}
+
+int SPI::write(const char *tx, int txlength, char *rx, int rxlength)
+{ // the CPU waits for the frame
+    if (rx)
+        memcpy(rx, m_chip.echo, rxlength < 3 ? rxlength : 3);
+    if (txlength == 3)
+        m_chip.Frame(tx);
+    m_writes++;
+    HostStall(Wiretime(txlength));
+    return (txlength);
+}
+
+void SPI::Schedule(const char *tx, int length, char *rx, const event_callback_t &callback, int event)
+{ // the frame follows the one before it on the wire
+    HostTransfer transfer;
+    pthread_mutex_lock(&hostlock);
+    m_free = (HostTime() > m_free ? HostTime() : m_free) + Wiretime(length);
+    transfer.time = m_free;
+    transfer.spi = this;
+    memcpy(transfer.tx, tx, length < 4 ? length : 4);
+    transfer.length = length;
+    transfer.rx = rx;
+    transfer.callback = callback;
+    transfer.event = event;
+    hosttransfers.push_back(transfer);
+    m_transfers++;
+    pthread_mutex_unlock(&hostlock);
+}
+
+int SPI::set_dma_usage(DMAUsage usage)
+{
+    return (0);
+}
+
+void SPI::abort_transfer(void)
+{
+}
+
+// pins and serial
+
+DigitalOut::DigitalOut(PinName pin, int value)
+{
+    m_value = value;
+}
+
+void DigitalOut::write(int value)
+{
+    m_value = value;
+}
+
+int DigitalOut::read(void)
+{
+    return (m_value);
+}
+
+DigitalOut &DigitalOut::operator=(int value)
+{
+    m_value = value;
+    return (*this);
+}
+
+DigitalOut::operator int()
+{
+    return (m_value);
+}
+
+DigitalIn::DigitalIn(PinName pin, PinMode mode)
+{
+}
+
+int DigitalIn::read(void)
+{
+    return (1);
+}
+
+DigitalIn::operator int()
+{
+    return (1);
+}
+
+Serial::Serial(PinName tx, PinName rx, int baud)
+{
+}
+
+void Serial::baud(int baud)
+{
+}
+
+int Serial::getc(void)
+{
+    return (EOF);
+}
+
+int Serial::putc(int c)
+{
+    return (putchar(c));
+}
+
+bool Serial::readable(void)
+{
+    return (false);
+}
+
+Serial::operator FILE *()
+{
+    return (stdout);
+}
+
+// flash
+
+static uint32_t HostSector(uint32_t offset, uint32_t *start)
+{ // the size of the sector holding the offset, 0 outside the flash
+    uint32_t first = 0, size;
+    for (int8_t sector = 0; sector < 12; sector++)
+    {
+        size = sector < 4 ? 0x8000 : sector == 4 ? 0x20000 : 0x40000;
+        if (offset < first + size)
+        {
+            if (start)
+                *start = first;
+            return (size);
+        }
+        first += size;
+    }
+    return (0);
+}
+
+void HostFlashfile(const char *path)
+{
+    if (hostflash)
+        fclose(hostflash);
+    hostflash = NULL;
+    hostflashfile = path;
+}
+
+uint32_t HostFlasherases(void)
+{
+    return (hosterases);
+}
+
+int FlashIAP::init(void)
+{ // a new file is an erased flash
+    if (hostflash)
+        return (0);
+    if (!(hostflash = fopen(hostflashfile, "r+b")))
+    {
+        if (!(hostflash = fopen(hostflashfile, "w+b")))
+            return (-1);
+        for (uint32_t i = 0; i < HOST_FLASHSIZE; i++)
+            fputc(0xff, hostflash);
+        fflush(hostflash);
+    }
+    setvbuf(hostflash, NULL, _IONBF, 0); // the tests corrupt the file behind FlashIAP's back
+    return (0);
+}
+
+int FlashIAP::deinit(void)
+{
+    return (0);
+}
+
+int FlashIAP::read(void *buffer, uint32_t addr, uint32_t size)
+{
+    if (!hostflash || addr < HOST_FLASHSTART || addr + size > HOST_FLASHSTART + HOST_FLASHSIZE)
+        return (-1);
+    fseek(hostflash, addr - HOST_FLASHSTART, SEEK_SET);
+    return (fread(buffer, 1, size, hostflash) == size ? 0 : -1);
+}
+
+int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
+{ // programming only clears bits, 16 us a word
+    uint8_t *flash = (uint8_t *)malloc(size);
+    int result = read(flash, addr, size);
+    if (!result)
+    {
+        for (uint32_t i = 0; i < size; i++)
+            flash[i] &= ((const uint8_t *)buffer)[i];
+        fseek(hostflash, addr - HOST_FLASHSTART, SEEK_SET);
+        result = fwrite(flash, 1, size, hostflash) == size ? 0 : -1;
+        HostStall((uint64_t)(size + 3) / 4 * 16000);
+    }
+    free(flash);
+    return (result);
+}
+
+int FlashIAP::erase(uint32_t addr, uint32_t size)
+{ // whole sectors, every instruction fetch stalls for 8 ms per KB
+    uint32_t offset = addr - HOST_FLASHSTART, start, sector;
+    if (!hostflash || addr < HOST_FLASHSTART)
+        return (-1);
+    while (size)
+    {
+        if (!(sector = HostSector(offset, &start)) || start != offset || size < sector)
+            return (-1);
+        fseek(hostflash, offset, SEEK_SET);
+        for (uint32_t i = 0; i < sector; i++)
+            fputc(0xff, hostflash);
+        HostStall((uint64_t)sector / 1024 * 8000000);
+        offset += sector, size -= sector;
+        hosterases++;
+    }
+    return (0);
+}
+
+uint32_t FlashIAP::get_page_size(void) const
+{
+    return (1);
+}
+
+uint32_t FlashIAP::get_sector_size(uint32_t addr) const
+{
+    uint32_t size = addr < HOST_FLASHSTART ? 0 : HostSector(addr - HOST_FLASHSTART, NULL);
+    return (size ? size : 0xffffffff);
+}
+
+uint32_t FlashIAP::get_flash_start(void) const
+{
+    return (HOST_FLASHSTART);
+}
+
+uint32_t FlashIAP::get_flash_size(void) const
+{
+    return (HOST_FLASHSIZE);
+}
+
+int HostReport(const char *name)
+{
+    printf("%s: %d checks, %d failed\n", name, hostchecks, hostfailures);
+    return (hostfailures ? 1 : 0);
+}
@@ -0,0 +1,70 @@
+// host.h ... the simulated board the host tests run the firmware against
+// Time is simulated in nanoseconds.  HostRun advances it in slices: the simulated VCOs make their
+// edges from the codes on the model LTC2668s, the edges are captured into the timers' CCRs or the DMA
+// buffers with the ICxPSC prescalers, and the timer updates and Tickers are pended.  Pended interrupts,
+// and the SPI transfers' completions, run as soon as the critical section or interrupt ends.  There is
+// one CPU, so a completion moves the time on to when the frame is off the wire, as if the thread spun
+// on Busy until then.
+#ifndef HOST_H
+#define HOST_H
+
+#include "mbed.h"
+#include "rtos.h"
+
+#define HOST_SLICE 20000     // ns of simulated time the VCOs' frequencies stay constant for
+#define HOST_CPUCLK 216      // DWT->CYCCNT counts per microsecond
+#define HOST_TIMERCLK 108    // TIM2 and TIM5 counts per microsecond, FREQUENCY
+#define HOST_FLASHSTART 0x08000000
+#define HOST_FLASHSIZE 0x200000
+
+struct HostVCO // a VCO driven by its voice's DAC.  The converter error in dins is
+// offset + drift * seconds + scale * (tritone - 11) + rolloff * 2**((tritone - 18) / 2)
+// where tritone is the code / 3264, the VCO's pitch in dins is the code less the error.
+{
+    bool running;     // false stops the edges
+    double offset;    // dins
+    double drift;     // dins per second
+    double scale;     // dins per tritone
+    double rolloff;   // dins at tritone 18
+    double settle;    // seconds, time constant of the pitch following the code
+    double jitter;    // seconds, each capture is off by up to this much
+    uint32_t glitch;  // an extra edge in every glitch'th period, 0 for none
+    double pitch;     // dins, where the VCO is now
+    double phase;     // of the current period, 0 to 1
+    uint32_t periods; // edges since the start
+};
+
+uint64_t HostNow(void);                 // simulated ns
+void HostRun(uint64_t ns);              // run the board for ns of simulated time
+void HostStall(uint64_t ns);            // the CPU and interrupts are stopped, the VCOs keep running
+void HostSetcount(int8_t timer, uint64_t count); // TIM2 (0) or TIM5 (1) counter from now on
+uint64_t HostGetcount(int8_t timer);
+HostVCO *HostGetVCO(int8_t voice);
+double HostError(int8_t voice, uint16_t code); // the voice's converter error in dins at the code now
+double HostError(int8_t voice, uint16_t code, double seconds);
+uint16_t HostCode(int8_t dac);          // the code on the output of a board DAC
+SPI *HostGetSPI(int8_t bus);            // the SPI of a DACBus
+void HostISR(Callback<void()> isr);    // run as an interrupt, pended interrupts follow it
+uint32_t HostIRQs(IRQn_Type irq, uint64_t *cpu); // times the vector ran and the host ns it took
+void HostFlashfile(const char *path);   // FlashIAP keeps the flash in this file
+uint32_t HostFlasherases(void);
+uint64_t HostCPU(void);                 // ns of host time, for the benchmarks
+
+void HostBoard(bool dma = true); // what main does before the menu: the board, the voices and the
+                                 // frequency timers, with FreqPoll when the captures use DMA
+extern Ticker hostpoll;
+
+extern int hostchecks, hostfailures;
+#define CHECK(cond)                                                                  \
+    do                                                                               \
+    {                                                                                \
+        hostchecks++;                                                                \
+        if (!(cond))                                                                 \
+        {                                                                            \
+            hostfailures++;                                                          \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                 \
+        }                                                                            \
+    } while (0)
+int HostReport(const char *name); // prints the counts, the exit status of the test
+
+#endif
@@ -0,0 +1,58 @@
+// hostboard.cpp ... the timers and the startup main.cpp would give the firmware on the board
+#include "mbed.h"
+#include "rtos.h"
+#include "main.h"
+#include "freq.h"
+#include "functimer.h"
+#include "board.h"
+#include "host.h"
+
+static void IRQ1()
+{
+    freqtimer0->irq_ic_timer();
+}
+FreqTimer t0(TIM2, RCC_APB1ENR_TIM2EN, TIM2_IRQn, (uint32_t)(uintptr_t)&IRQ1, PRESCALER, 0);
+FreqTimer *freqtimer0 = &t0;
+
+static void IRQ2()
+{
+    freqtimer1->irq_ic_timer();
+}
+FreqTimer t1(TIM5, RCC_APB1ENR_TIM5EN, TIM5_IRQn, (uint32_t)(uintptr_t)&IRQ2, PRESCALER, 1);
+FreqTimer *freqtimer1 = &t1;
+
+static void FIRQ0()
+{
+    functimer0->irq_ic_timer();
+}
+FuncTimer ft0(TIM3, RCC_APB1ENR_TIM3EN, TIM3_IRQn, (uint32_t)(uintptr_t)&FIRQ0, FREQUENCY / 10000 - 1, 1000, 0);
+FuncTimer *functimer0 = &ft0;
+
+static void FIRQ1()
+{
+    functimer1->irq_ic_timer();
+}
+FuncTimer ft1(TIM7, RCC_APB1ENR_TIM7EN, TIM7_IRQn, (uint32_t)(uintptr_t)&FIRQ1, FREQUENCY / 40000 - 1, 1000, 0);
+FuncTimer *functimer1 = &ft1;
+
+Ticker hostpoll;
+
+void HostBoard(bool dma)
+{ // main without the span checks, the ADCs and the menu
+    SetupBoard();
+    SetupSPIs();
+    SetupVoices();
+    if (dma)
+    {
+        t0.start_dma(FreqVoiced(0), FreqVoiced(1), FreqVoiced(2), FreqVoiced(3));
+        hostpoll.attach_us(callback(FreqPoll), 1000000 / FREQ_POLLRATE);
+        t1.start_dma(FreqVoiced(4), FreqVoiced(5), FreqVoiced(6), FreqVoiced(7));
+    }
+    else
+    {
+        for (int8_t i = 0; i < NUMBERFREQS; i++)
+            freqchannels[i].Setdma(NULL, 0);
+        t0.start_action(FreqVoiced(0), FreqVoiced(1), FreqVoiced(2), FreqVoiced(3));
+        t1.start_action(FreqVoiced(4), FreqVoiced(5), FreqVoiced(6), FreqVoiced(7));
+    }
+}
@@ -0,0 +1,468 @@
+// mbed.h ... host stand-in for the mbed-os API and the STM32F767 registers the firmware uses
+// The registers are plain memory which host.cpp's simulation reads and writes, interrupts are pended
+// and run when the critical section ends, and time is simulated, see host.h.
+#ifndef MBED_H
+#define MBED_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define DEVICE_SPI_ASYNCH 1
+#define DEVICE_FLASH 1
+#define __DCACHE_PRESENT 1U
+
+// registers
+
+typedef struct
+{
+    volatile uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR;
+    volatile uint32_t CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR;
+} TIM_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2];
+} GPIO_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t APB1ENR, AHB1ENR;
+} RCC_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t CR, NDTR, PAR, M0AR, M1AR, FCR;
+} DMA_Stream_TypeDef;
+
+struct HostCycles // DWT->CYCCNT counts CPUCLK cycles of simulated time
+{
+    operator uint32_t() const;
+};
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    HostCycles CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern TIM_TypeDef host_tim[4];
+extern GPIO_TypeDef host_gpio[7];
+extern RCC_TypeDef host_rcc;
+extern DMA_Stream_TypeDef host_dma1[8];
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_coredebug;
+
+#define TIM2 (&host_tim[0])
+#define TIM3 (&host_tim[1])
+#define TIM5 (&host_tim[2])
+#define TIM7 (&host_tim[3])
+#define GPIOA (&host_gpio[0])
+#define GPIOB (&host_gpio[1])
+#define GPIOC (&host_gpio[2])
+#define GPIOD (&host_gpio[3])
+#define GPIOE (&host_gpio[4])
+#define GPIOF (&host_gpio[5])
+#define GPIOG (&host_gpio[6])
+#define RCC (&host_rcc)
+#define DMA1_Stream0 (&host_dma1[0])
+#define DMA1_Stream1 (&host_dma1[1])
+#define DMA1_Stream2 (&host_dma1[2])
+#define DMA1_Stream3 (&host_dma1[3])
+#define DMA1_Stream4 (&host_dma1[4])
+#define DMA1_Stream5 (&host_dma1[5])
+#define DMA1_Stream6 (&host_dma1[6])
+#define DMA1_Stream7 (&host_dma1[7])
+#define DWT (&host_dwt)
+#define CoreDebug (&host_coredebug)
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1u << 24)
+#define DWT_CTRL_CYCCNTENA_Msk 1u
+#define RESET 0
+
+#define TIM_CR1_CEN 0x1u
+#define TIM_CR1_URS 0x4u
+#define TIM_CR1_DIR 0x10u
+#define TIM_CR1_CMS 0x60u
+#define TIM_CR1_CKD 0x300u
+#define TIM_COUNTERMODE_UP 0x0u
+#define TIM_CLOCKDIVISION_DIV1 0x0u
+#define TIM_EGR_UG 0x1u
+#define TIM_SMCR_SMS 0x7u
+#define TIM_SR_UIF 0x1u
+#define TIM_SR_CC1IF 0x2u
+#define TIM_SR_CC2IF 0x4u
+#define TIM_SR_CC3IF 0x8u
+#define TIM_SR_CC4IF 0x10u
+#define TIM_DIER_UIE 0x1u
+#define TIM_DIER_CC1IE 0x2u
+#define TIM_DIER_CC2IE 0x4u
+#define TIM_DIER_CC3IE 0x8u
+#define TIM_DIER_CC4IE 0x10u
+#define TIM_DIER_CC1DE 0x200u
+#define TIM_DIER_CC2DE 0x400u
+#define TIM_DIER_CC3DE 0x800u
+#define TIM_DIER_CC4DE 0x1000u
+#define TIM_CCMR1_CC1S 0x3u
+#define TIM_CCMR1_CC1S_0 0x1u
+#define TIM_CCMR1_IC1PSC 0xcu
+#define TIM_CCMR1_IC1PSC_Pos 2
+#define TIM_CCMR1_IC1F 0xf0u
+#define TIM_CCMR1_CC2S 0x300u
+#define TIM_CCMR1_CC2S_0 0x100u
+#define TIM_CCMR1_IC2PSC 0xc00u
+#define TIM_CCMR1_IC2F 0xf000u
+#define TIM_CCMR2_CC3S 0x3u
+#define TIM_CCMR2_CC3S_0 0x1u
+#define TIM_CCMR2_IC3PSC 0xcu
+#define TIM_CCMR2_IC3F 0xf0u
+#define TIM_CCMR2_CC4S 0x300u
+#define TIM_CCMR2_CC4S_0 0x100u
+#define TIM_CCMR2_IC4PSC 0xc00u
+#define TIM_CCMR2_IC4F 0xf000u
+#define TIM_CCER_CC1E 0x1u
+#define TIM_CCER_CC1P 0x2u
+#define TIM_CCER_CC1NP 0x8u
+#define TIM_CCER_CC2E 0x10u
+#define TIM_CCER_CC2P 0x20u
+#define TIM_CCER_CC2NP 0x80u
+#define TIM_CCER_CC3E 0x100u
+#define TIM_CCER_CC3P 0x200u
+#define TIM_CCER_CC3NP 0x800u
+#define TIM_CCER_CC4E 0x1000u
+#define TIM_CCER_CC4P 0x2000u
+#define TIM_CCER_CC4NP 0x8000u
+#define RCC_APB1ENR_TIM2EN 0x1u
+#define RCC_APB1ENR_TIM3EN 0x2u
+#define RCC_APB1ENR_TIM5EN 0x8u
+#define RCC_APB1ENR_TIM7EN 0x20u
+#define RCC_AHB1ENR_GPIOAEN 0x1u
+#define RCC_AHB1ENR_GPIOBEN 0x2u
+#define RCC_AHB1ENR_GPIOGEN 0x40u
+#define RCC_AHB1ENR_DMA1EN 0x200000u
+#define DMA_SxCR_EN 0x1u
+#define DMA_SxCR_CIRC 0x100u
+#define DMA_SxCR_MINC 0x400u
+#define DMA_SxCR_PSIZE_1 0x1000u
+#define DMA_SxCR_MSIZE_1 0x4000u
+#define DMA_SxCR_PL_0 0x10000u
+#define DMA_SxCR_CHSEL_Pos 25
+
+typedef enum
+{ // the timers' vectors, host_tim has the same order
+    TIM2_IRQn,
+    TIM3_IRQn,
+    TIM5_IRQn,
+    TIM7_IRQn,
+    HOST_IRQS
+} IRQn_Type;
+
+void NVIC_SetVector(IRQn_Type irq, uint32_t vector); // the firmware casts the handler, link with -no-pie
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_EnableIRQ(IRQn_Type irq);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_IPSR(void);
+void SCB_InvalidateDCache_by_Addr(uint32_t *addr, int32_t size);
+void core_util_critical_section_enter(void);
+void core_util_critical_section_exit(void);
+bool core_util_is_isr_active(void);
+
+uint32_t us_ticker_read(void);
+void wait(float s);
+void wait_ms(int ms);
+void wait_us(int us);
+
+typedef enum
+{
+    PA_0, PA_4, PB_9, PB_13, PB_14, PB_15, PC_10, PC_11, PC_12, PD_7, PE_2, PE_4, PE_5, PE_6, PE_7,
+    PF_6, PF_7, PF_8, PF_9, PG_0, PG_1, PG_8, PG_9, PG_10, PG_11, PG_12, PG_13, PG_14, PG_15,
+    LED1, LED2, LED3, USER_BUTTON, SERIAL_TX, SERIAL_RX, NC
+} PinName;
+
+typedef enum
+{
+    PullNone,
+    PullUp,
+    PullDown
+} PinMode;
+
+typedef enum
+{
+    DMA_USAGE_NEVER,
+    DMA_USAGE_OPPORTUNISTIC,
+    DMA_USAGE_ALWAYS
+} DMAUsage;
+
+#define SPI_EVENT_ERROR 0x2
+#define SPI_EVENT_COMPLETE 0x4
+#define SPI_EVENT_RX_OVERFLOW 0x8
+#define SPI_EVENT_ALL 0xe
+
+namespace mbed
+{
+
+template <typename F>
+class Callback;
+
+template <typename R>
+class Callback<R()>
+{ // a function, a function with its argument or an object and its method
+  private:
+    void *m_obj;
+    char m_storage[2 * sizeof(void *)]; // a function pointer or a pointer to a member function
+    R (*m_thunk)(void *obj, const void *storage);
+    template <typename T>
+    static R Method(void *obj, const void *storage)
+    {
+        R (T::*method)();
+        memcpy(&method, storage, sizeof(method));
+        return ((((T *)obj)->*method)());
+    }
+    template <typename T>
+    static R Bound(void *obj, const void *storage)
+    {
+        R (*func)(T *);
+        memcpy(&func, storage, sizeof(func));
+        return (func((T *)obj));
+    }
+    static R Function(void *obj, const void *storage)
+    {
+        R (*func)();
+        memcpy(&func, storage, sizeof(func));
+        return (func());
+    }
+
+  public:
+    Callback(void) : m_obj(NULL), m_thunk(NULL) {}
+    Callback(R (*func)()) : m_obj(NULL), m_thunk(&Function)
+    {
+        memcpy(m_storage, &func, sizeof(func));
+    }
+    template <typename T>
+    Callback(R (*func)(T *), T *arg) : m_obj(arg), m_thunk(&Bound<T>)
+    {
+        memcpy(m_storage, &func, sizeof(func));
+    }
+    template <typename T>
+    Callback(T *obj, R (T::*method)()) : m_obj(obj), m_thunk(&Method<T>)
+    {
+        memcpy(m_storage, &method, sizeof(method));
+    }
+    R operator()(void) const
+    {
+        return (m_thunk(m_obj, m_storage));
+    }
+    operator bool() const
+    {
+        return (m_thunk != NULL);
+    }
+};
+
+template <typename R, typename A0>
+class Callback<R(A0)>
+{
+  private:
+    void *m_obj;
+    char m_storage[2 * sizeof(void *)];
+    R (*m_thunk)(void *obj, const void *storage, A0 a0);
+    template <typename T>
+    static R Method(void *obj, const void *storage, A0 a0)
+    {
+        R (T::*method)(A0);
+        memcpy(&method, storage, sizeof(method));
+        return ((((T *)obj)->*method)(a0));
+    }
+    static R Function(void *obj, const void *storage, A0 a0)
+    {
+        R (*func)(A0);
+        memcpy(&func, storage, sizeof(func));
+        return (func(a0));
+    }
+
+  public:
+    Callback(void) : m_obj(NULL), m_thunk(NULL) {}
+    Callback(R (*func)(A0)) : m_obj(NULL), m_thunk(&Function)
+    {
+        memcpy(m_storage, &func, sizeof(func));
+    }
+    template <typename T>
+    Callback(T *obj, R (T::*method)(A0)) : m_obj(obj), m_thunk(&Method<T>)
+    {
+        memcpy(m_storage, &method, sizeof(method));
+    }
+    R operator()(A0 a0) const
+    {
+        return (m_thunk(m_obj, m_storage, a0));
+    }
+    operator bool() const
+    {
+        return (m_thunk != NULL);
+    }
+};
+
+template <typename R>
+Callback<R()> callback(R (*func)())
+{
+    return (Callback<R()>(func));
+}
+
+template <typename R, typename T, typename U>
+Callback<R()> callback(R (*func)(T *), U *arg)
+{
+    return (Callback<R()>(func, (T *)arg));
+}
+
+template <typename R, typename T, typename U>
+Callback<R()> callback(U *obj, R (T::*method)())
+{
+    return (Callback<R()>((T *)obj, method));
+}
+
+template <typename R, typename T, typename U, typename A0>
+Callback<R(A0)> callback(U *obj, R (T::*method)(A0))
+{
+    return (Callback<R(A0)>((T *)obj, method));
+}
+
+} // namespace mbed
+
+using namespace mbed;
+typedef Callback<void(int)> event_callback_t;
+
+struct HostChip // the LTC2668 on an SPI, decodes the command frames
+{
+    uint16_t input[2][16]; // input registers A and B
+    uint16_t dac[2][16];   // DAC registers A and B
+    uint8_t span[16];
+    uint16_t toggle; // toggle select, codes for these channels go to register B
+    bool tgb;        // global toggle bit
+    uint32_t frames;
+    char echo[3]; // SDO shifts out the previous frame
+    void Frame(const char *frame);
+    uint16_t Code(int8_t channel); // the code on the channel's output
+};
+
+class SPI // blocking writes take the frame's wire time of simulated time, a transfer completes at
+// the time the bus is free plus its wire time, when the interrupts are enabled again
+{
+  private:
+    void Schedule(const char *tx, int length, char *rx, const event_callback_t &callback, int event);
+
+  public:
+    HostChip m_chip;
+    uint32_t m_hz, m_transfers, m_writes;
+    uint64_t m_free;  // simulated ns when the last scheduled frame is off the wire
+    uint32_t m_fails; // the next transfers complete with SPI_EVENT_ERROR
+    SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel = NC);
+    void format(int bits, int mode = 0);
+    void frequency(int hz);
+    int write(int value);
+    int write(const char *tx, int txlength, char *rx, int rxlength);
+    template <typename T>
+    int transfer(const T *tx, int txlength, T *rx, int, const event_callback_t &callback,
+                 int event = SPI_EVENT_COMPLETE)
+    {
+        Schedule((const char *)tx, txlength * sizeof(T), (char *)rx, callback, event);
+        return (0);
+    }
+    int set_dma_usage(DMAUsage usage);
+    void abort_transfer(void);
+    uint64_t Wiretime(int bytes); // ns
+};
+
+class DigitalOut
+{
+  private:
+    int m_value;
+
+  public:
+    DigitalOut(PinName pin, int value = 0);
+    void write(int value);
+    int read(void);
+    DigitalOut &operator=(int value);
+    operator int();
+};
+
+class DigitalIn // reads 1, an ADC's BUSY is never low
+{
+  public:
+    DigitalIn(PinName pin, PinMode mode = PullNone);
+    int read(void);
+    operator int();
+};
+
+class Serial
+{
+  public:
+    Serial(PinName tx, PinName rx, int baud = 9600);
+    void baud(int baud);
+    int getc(void);
+    int putc(int c);
+    bool readable(void);
+    operator FILE *();
+};
+
+class Timer // simulated time
+{
+  private:
+    uint64_t m_start, m_total;
+    bool m_running;
+
+  public:
+    Timer(void);
+    void start(void);
+    void stop(void);
+    void reset(void);
+    float read(void);
+    int read_ms(void);
+    int read_us(void);
+};
+
+class Ticker // runs in the simulated interrupt context every period of simulated time
+{
+  public:
+    Callback<void()> m_callback;
+    uint64_t m_period, m_next; // ns
+    bool m_pending;
+    Ticker(void);
+    ~Ticker(void);
+    void attach_us(Callback<void()> callback, uint32_t us);
+    void attach(Callback<void()> callback, float s);
+    void detach(void);
+};
+
+class FlashIAP // STM32F767 single bank, 2 MB in four 32 KB, one 128 KB and seven 256 KB sectors, kept
+// in a file.  Erased bytes are 0xff and programming can only clear bits.  An erase stalls the
+// simulated CPU for the sector's erase time.
+{
+  public:
+    int init(void);
+    int deinit(void);
+    int read(void *buffer, uint32_t addr, uint32_t size);
+    int program(const void *buffer, uint32_t addr, uint32_t size);
+    int erase(uint32_t addr, uint32_t size);
+    uint32_t get_page_size(void) const;
+    uint32_t get_sector_size(uint32_t addr) const;
+    uint32_t get_flash_start(void) const;
+    uint32_t get_flash_size(void) const;
+};
+
+#include "rtos.h" // mbed-os 5's mbed.h brings in the RTOS
+
+// The firmware's diagnostics go to host_firmware.log, so a test's output is only its own
+#define HOST_LOG "host_firmware.log"
+int HostPrintf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+#ifdef HOST_FIRMWARE
+#define printf HostPrintf
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+// rtos.h ... host stand-in for the mbed-os RTOS classes
+// Threads are not run, the tests call the thread functions themselves.  Waits run the simulation.
+#ifndef RTOS_H
+#define RTOS_H
+
+#include "mbed.h"
+
+#define osWaitForever 0xffffffffu
+
+typedef enum
+{
+    osOK = 0,
+    osErrorResource = 0x81
+} osStatus;
+
+class Thread
+{
+  private:
+    Callback<void()> m_task;
+    bool m_started;
+
+  public:
+    Thread(void);
+    osStatus start(Callback<void()> task); // recorded, not run
+    osStatus join(void);
+    osStatus terminate(void);
+    bool Started(void);
+    static osStatus wait(uint32_t ms); // the simulation runs for ms
+    static osStatus yield(void);
+};
+
+class Semaphore // Release comes from the simulated interrupts, so a wait runs the simulation until
+// there is a token or the time is up
+{
+  private:
+    volatile int32_t m_count;
+
+  public:
+    Semaphore(int32_t count = 0);
+    int32_t wait(uint32_t ms = osWaitForever); // tokens before this one was taken, 0 on a timeout
+    osStatus release(void);
+};
+
+class Mutex
+{
+  public:
+    osStatus lock(uint32_t ms = osWaitForever);
+    osStatus unlock(void);
+};
+
+#endif
@@ -0,0 +1,122 @@
+// test_calibration.cpp ... the calibration records in the file backed flash
+//   save and load of every VCO's offsets, a corrupted record leaving its VCO untuned
+//   the spot-check of the loaded offsets against the simulated converters
+#include <stdio.h>
+#include <stddef.h>
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "board.h"
+#include "calibration.h"
+#include "host.h"
+
+#define TEST_FLASH "host_flash_test.bin"
+#define TEST_MS 1000000ULL // ns
+
+static int16_t offsets[NUMBERVCOS][CAL_OFFSETS];
+
+static void Tune(void)
+{ // the offsets Autotune would find for the simulated converters
+    VCO *vco;
+    OctaveXstep ox;
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+    {
+        vco = VCOS[voice];
+        HostGetVCO(voice)->offset = 30.0 + voice * 7;
+        HostGetVCO(voice)->scale = 2.0 - voice * 0.5;
+        for (int8_t tritone = 0; tritone < vco->Gettritones(); tritone++)
+        {
+            ox = vco->Tritone(tritone);
+            offsets[voice][tritone] = (int16_t)floor(HostError(voice, vco->Dinx(ox.octave, ox.xstep)) + 0.5);
+        }
+        vco->Setoffsets(offsets[voice], vco->Gettritones());
+    }
+}
+
+static void Untune(void)
+{ // as after a power cycle
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        VCOS[voice]->Tunebegin();
+}
+
+static bool Same(int8_t voice)
+{
+    for (int8_t tritone = 0; tritone < VCOS[voice]->Gettritones(); tritone++)
+        if (VCOS[voice]->Getoffset(tritone) != offsets[voice][tritone])
+            return (false);
+    return (true);
+}
+
+static void Corrupt(uint32_t offset)
+{ // flip a bit of the file behind FlashIAP's back
+    FILE *file = fopen(TEST_FLASH, "r+b");
+    int byte;
+    fseek(file, offset, SEEK_SET);
+    byte = fgetc(file);
+    fseek(file, offset, SEEK_SET);
+    fputc(byte ^ 0x10, file);
+    fclose(file);
+}
+
+static void TestStore(bool bench)
+{ // the records survive a power cycle and a bad one only costs its VCO's tuning
+    Calibration saved, loaded, corrupted, erased;
+    uint64_t start;
+    uint32_t erases = HostFlasherases();
+    Tune();
+    start = HostNow();
+    CHECK(saved.Save());
+    start = HostNow() - start;
+    CHECK(HostFlasherases() == erases + 1);
+    Untune();
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        CHECK(!VCOS[voice]->Gettuned());
+    CHECK(loaded.Load() == NUMBERVCOS);
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        CHECK(VCOS[voice]->Gettuned() && Same(voice));
+    if (bench)
+        printf("Saved %d VCOs in %.0f ms of stalled flash, %s", NUMBERVCOS, start / 1e6, loaded.print());
+    Untune();
+    Corrupt(CAL_APPSIZE + 2 * sizeof(CalRecord) + offsetof(CalRecord, offsets) + 5);
+    CHECK(corrupted.Load() == NUMBERVCOS - 1);
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        CHECK(VCOS[voice]->Gettuned() == (voice != 2));
+    CHECK(!strncmp(strstr(corrupted.print(), "failed"), "failed 1", 8));
+    if (bench)
+        printf("  a bit flipped in VCO 2's offsets, %s", corrupted.print());
+    Untune();
+    remove(TEST_FLASH);
+    HostFlashfile(TEST_FLASH); // erased
+    CHECK(erased.Load() == 0);
+    CHECK(!strncmp(strstr(erased.print(), "failed"), "failed 0", 8));
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        CHECK(!VCOS[voice]->Gettuned());
+}
+
+static void TestCheck(bool bench)
+{ // the spot-check passes the loaded offsets until the converter drifts
+    Calibration calibration;
+    Tune();
+    HostRun(1000 * TEST_MS); // the frequency channels lower their prescalers
+    CHECK(calibration.Check(VCOS[1]));
+    CHECK(!VCOS[1]->Getretuning()); // the voice is given back to VCOAdj0
+    HostGetVCO(1)->offset += 3 * CAL_SPOTCHECK;
+    CHECK(!calibration.Check(VCOS[1]));
+    CHECK(calibration.Check(VCOS[2]));
+    if (bench)
+        printf("  the spot-check fails %d dins of drift\n", 3 * CAL_SPOTCHECK);
+}
+
+int main(int argc, char **argv)
+{
+    bool bench = argc > 1 && !strcmp(argv[1], "bench");
+    remove(TEST_FLASH);
+    HostFlashfile(TEST_FLASH);
+    HostBoard();
+    TestStore(bench);
+    TestCheck(bench);
+    remove(TEST_FLASH);
+    return (HostReport("test_calibration"));
+}
@@ -0,0 +1,181 @@
+// test_dacbus.cpp ... the DACBus frame queue against the simulated LTC2668s
+//   ISR time of a FuncTimer tick with blocking SPI writes and with the queued frames
+//   shadow codes suppressing the writes which would not change the output, a failed frame resending
+//   the four buses running a batch in parallel at several SPI clocks
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "dacbus.h"
+#include "envelope.h"
+#include "functimer.h"
+#include "board.h"
+#include "host.h"
+
+#define TEST_ENVS 16 // four envelopes on each bus
+
+static int8_t Envdac(int8_t env)
+{ // channels 12 to 15 of each chip, none of them drive a VCO
+    return ((env & 3) * 16 + 12 + (env >> 2));
+}
+
+static uint64_t isrtime, isrcpu; // simulated and host ns of the last tick
+
+static void Tick(void)
+{ // the update interrupt of ft0, the host time of a blocking tick includes simulating the wire
+    uint64_t start = HostNow(), cpu = HostCPU();
+    TIM3->SR |= TIM_SR_UIF;
+    functimer0->irq_ic_timer();
+    isrcpu = HostCPU() - cpu;
+    isrtime = HostNow() - start;
+}
+
+static void Ticks(bool async, int ticks, bool bench)
+{ // simulated ISR time is the time the blocking writes keep the CPU on the wire
+    uint64_t isr = 0, cpu = 0;
+    uint32_t frames = 0;
+    for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+    {
+        DACBUSES[bus]->SetAsync(async);
+        frames -= HostGetSPI(bus)->m_chip.frames;
+    }
+    for (int i = 0; i < ticks; i++)
+    {
+        HostISR(callback(&Tick));
+        cpu += isrcpu;
+        isr += isrtime;
+        HostRun(100000); // ft0 ticks at 10 kHz
+    }
+    DACBusWait();
+    for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+        frames += HostGetSPI(bus)->m_chip.frames;
+    for (int8_t env = 0; env < TEST_ENVS; env++)
+        CHECK(HostCode(Envdac(env)) == (uint16_t)dacs[Envdac(env)].Getvoutdin());
+    CHECK(frames >= (uint32_t)ticks * TEST_ENVS * 9 / 10); // the ramps change the codes nearly every tick
+    if (async)
+        CHECK(isr * 10 < (uint64_t)ticks * TEST_ENVS * HostGetSPI(0)->Wiretime(DACBUS_FRAMESIZE));
+    else
+        CHECK(isr >= (uint64_t)ticks * TEST_ENVS * HostGetSPI(0)->Wiretime(DACBUS_FRAMESIZE) * 9 / 10);
+    if (bench)
+        printf("  %-8s %5.2f us simulated ISR time, %6.0f ns host CPU per tick, %lu frames\n",
+               async ? "queued" : "blocking", isr / 1000.0 / ticks, (double)cpu / ticks,
+               (long unsigned int)frames);
+}
+
+static void TestTick(bool bench)
+{ // the ISR only queues the frames
+    Envelope *envs[TEST_ENVS];
+    functimer0->Clear();
+    for (int8_t env = 0; env < TEST_ENVS; env++)
+    {
+        envs[env] = new Envelope(env, &dacs[Envdac(env)], true);
+        envs[env]->Add(1000 + env * 100, 60000, 400, 1, -1, NULL);
+        envs[env]->Add(60000, 1000 + env * 100, 400, 1, -1, NULL);
+        envs[env]->Start();
+        functimer0->Add(envs[env]);
+    }
+    if (bench)
+        printf("FuncTimer tick, %d envelopes on 4 buses at 5 MHz\n", TEST_ENVS);
+    Ticks(false, bench ? 4000 : 400, bench);
+    Ticks(true, bench ? 4000 : 400, bench);
+    functimer0->Clear();
+    for (int8_t env = 0; env < TEST_ENVS; env++)
+        delete envs[env];
+}
+
+static void TestShadow(void)
+{ // a code the channel already has is not sent again
+    LTC2668 *dac = &dacs[13];
+    DACBus *bus = dac->GetBus();
+    HostChip *chip = &HostGetSPI(0)->m_chip;
+    uint32_t frames, suppressed = bus->Getsuppressed();
+    dac->Voutprim(12345);
+    frames = chip->frames;
+    dac->Voutprim(12345);
+    dac->Voutprim(12345);
+    CHECK(chip->frames == frames);
+    CHECK(bus->Getsuppressed() == suppressed + 2);
+    dac->Voutprim(12346);
+    CHECK(chip->frames == frames + 1);
+    CHECK(HostCode(13) == 12346);
+    bus->Forget(13);
+    dac->Voutprim(12346);
+    CHECK(chip->frames == frames + 2);
+    // a frame the SPI failed leaves the code on the wire unknown, so the same code is sent again
+    HostGetSPI(0)->m_fails = 1;
+    dac->Voutprim(12347);
+    DACBusWait();
+    CHECK(HostCode(13) == 12346);
+    CHECK(strstr(bus->print(), "errors 1 "));
+    frames = chip->frames;
+    dac->Voutprim(12347);
+    CHECK(chip->frames == frames + 1);
+    CHECK(HostCode(13) == 12347);
+    // a toggled channel's code goes to register A or B, so it is always sent
+    dac->Settoggle(20000, 30000);
+    frames = chip->frames;
+    dac->Voutprim(30000);
+    dac->Voutprim(30000);
+    CHECK(chip->frames == frames + 2);
+    dac->Cleartoggle();
+    // while held only the last code staged for the channel is sent
+    DACBusHold();
+    dac->Voutprim(1000);
+    dac->Voutprim(2000);
+    dac->Voutprim(3000);
+    frames = chip->frames;
+    DACBusFlush();
+    DACBusWait();
+    CHECK(chip->frames == frames + 1);
+    CHECK(HostCode(13) == 3000);
+}
+
+static void TestBuses(bool bench)
+{ // a batch takes as long as the busiest bus
+    static const int hz[] = {1000000, 5000000, 10000000, 25000000};
+    static const int8_t batch[NUMBERDACBUSES] = {16, 8, 4, 2}; // channels written on each bus
+    uint32_t longest, expect;
+    if (bench)
+        printf("A batch of 16, 8, 4 and 2 channels on buses 0 to 3\n");
+    for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+        DACBUSES[bus]->SetAsync(true);
+    for (size_t i = 0; i < sizeof(hz) / sizeof(hz[0]); i++)
+    {
+        for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+            HostGetSPI(bus)->frequency(hz[i]);
+        DACBusHold();
+        for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+            for (int8_t channel = 0; channel < batch[bus]; channel++)
+                dacs[bus * 16 + channel].Voutprim(4000 + i * 1000 + channel);
+        DACBusFlush();
+        longest = DACBusWait();
+        for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+        {
+            expect = HostGetSPI(bus)->Wiretime(DACBUS_FRAMESIZE) * batch[bus] / 1000;
+            CHECK(DACBUSES[bus]->Getburst() + 1 >= expect && DACBUSES[bus]->Getburst() <= expect + 1);
+            for (int8_t channel = 0; channel < batch[bus]; channel++)
+                CHECK(HostCode(bus * 16 + channel) == 4000 + i * 1000 + channel);
+        }
+        CHECK(longest == DACBUSES[0]->Getburst());
+        if (bench)
+            printf("  %2d MHz  bus 0 %4lu us  bus 1 %4lu us  bus 2 %4lu us  bus 3 %4lu us  batch %4lu us, %4lu us one bus at a time\n",
+                   hz[i] / 1000000,
+                   (long unsigned int)DACBUSES[0]->Getburst(), (long unsigned int)DACBUSES[1]->Getburst(),
+                   (long unsigned int)DACBUSES[2]->Getburst(), (long unsigned int)DACBUSES[3]->Getburst(),
+                   (long unsigned int)longest,
+                   (long unsigned int)(HostGetSPI(0)->Wiretime(DACBUS_FRAMESIZE) * 30 / 1000));
+    }
+    for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+        HostGetSPI(bus)->frequency(5000000);
+}
+
+int main(int argc, char **argv)
+{
+    bool bench = argc > 1 && !strcmp(argv[1], "bench");
+    HostBoard();
+    TestTick(bench);
+    TestShadow();
+    TestBuses(bench);
+    return (HostReport("test_dacbus"));
+}
@@ -0,0 +1,184 @@
+// test_envelope.cpp ... the envelopes and waves a FuncTimer tick plays
+//   a long steep segment ending exactly on its end code, with a fractional hold
+//   waves of full scale steps interpolated at a fractional rate
+//   EnvBank against the Envelope objects at 16, 32 and 64 envelopes, the same codes and the time of a tick
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "dacbus.h"
+#include "envelope.h"
+#include "envbank.h"
+#include "functimer.h"
+#include "waves.h"
+#include "board.h"
+#include "host.h"
+
+#define TEST_TICK 100000ULL // ns, ft0 ticks at 10 kHz
+
+static void TestSegment(bool bench)
+{ // full scale over 48000 ticks, 32 bits of m_cnt * m_change would have overflowed
+    LTC2668 *dac = &dacs[12];
+    Envelope envelope(-1, dac);
+    Segment *segment;
+    uint32_t ticks = 0, wrong = 0, backwards = 0;
+    int32_t last = 0;
+    double exact;
+    envelope.Add(0, 65535, 32000, 1, -1, NULL);
+    segment = envelope.Getsegment(0);
+    segment->SetHold(SEGMENT_HOLDONE * 3 / 2); // 1.5 ticks per interval
+    CHECK(segment->Getticks() == 48000);
+    envelope.Start();
+    while (!envelope.Next())
+    {
+        ticks++;
+        exact = 65535.0 * ticks / segment->Getticks();
+        wrong += fabs((uint16_t)dac->Getvoutdin() - exact) > 1.0;
+        backwards += (uint16_t)dac->Getvoutdin() < last;
+        last = (uint16_t)dac->Getvoutdin();
+    }
+    CHECK(ticks + 1 == segment->Getticks());
+    CHECK((uint16_t)dac->Getvoutdin() == 65535);
+    CHECK(!wrong);
+    CHECK(!backwards);
+    if (bench)
+        printf("0 to 65535 in %lu ticks, ends on %ld, %lu codes more than one off the line\n",
+               (long unsigned int)segment->Getticks(), (long int)(uint16_t)dac->Getvoutdin(), (long unsigned int)wrong);
+}
+
+static void TestWave(bool bench)
+{ // steps from 2 to 65535 and back, a 16 bit fraction of them overflows 32 bits
+    static const uint16_t points[] = {2, 65535, 2, 65535, 2, 1};
+    static const Wave wave = {points, 5, 5};
+    static const uint32_t rates[] = {0x1000, 0x4000, 0x8001, 0xc000};
+    LTC2668 *dac = &dacs[13];
+    uint32_t phase, wrong = 0;
+    int32_t offset;
+    double exact;
+    dac->Setwave(&wave);
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        dac->Setrate(rates[i]);
+        dac->Start();
+        for (phase = 0; dac->Next() == NextPoint; phase += rates[i])
+        { // the last point stays out until the phase reaches the end marker
+            offset = phase >> 16;
+            exact = points[offset + 1] > 1 ? points[offset] + (points[offset + 1] - points[offset]) * ((phase & 0xffff) / 65536.0)
+                                           : points[offset];
+            wrong += fabs((uint16_t)dac->Getvoutdin() - exact) > 2.0; // the fraction is 15 bits
+        }
+        CHECK(phase >> 16 == 5);
+    }
+    CHECK(!wrong);
+    if (bench)
+        printf("Full scale steps at 1/16 to 3/4 points a tick, %lu codes off the line\n", (long unsigned int)wrong);
+    dac->Setwave(NULL);
+}
+
+#define TEST_ENVS 64
+
+static Envelope *envelopes[TEST_ENVS];
+static EnvBank bank;
+static uint64_t tickcpu;
+
+static void Tick(void)
+{ // the update interrupt of ft0
+    uint64_t cpu = HostCPU();
+    TIM3->SR |= TIM_SR_UIF;
+    functimer0->irq_ic_timer();
+    tickcpu += HostCPU() - cpu;
+}
+
+static int8_t Envdac(int8_t env)
+{ // the channels without a VCO, the envelopes beyond them share
+    int8_t dac = -1, voice, free = env % (NUMBERDACS - NUMBERVCOS) + 1;
+    while (free)
+    {
+        dac++;
+        for (voice = 0; voice < NUMBERVCOS && VOICEBOARD[voice].dac != dac; voice++)
+            ;
+        free -= voice == NUMBERVCOS;
+    }
+    return (dac);
+}
+
+static void Envelopes(void)
+{ // an attack, a decay, a sustain and a curved release, each envelope a little different
+    for (int8_t env = 0; env < TEST_ENVS; env++)
+    {
+        envelopes[env] = new Envelope(-1, &dacs[Envdac(env)], true);
+        envelopes[env]->Add(1000, 60000 - env * 200, 50 + env, 1, -1, NULL);
+        envelopes[env]->Add(60000 - env * 200, 40000, 120, 2, -1, NULL, CurveLog);
+        envelopes[env]->Add(40000, 40000, 100, 3, -1, NULL);
+        envelopes[env]->Add(40000, 1000, 200 + env * 3, 1, -1, NULL, CurveExp);
+    }
+}
+
+static void Run(int8_t count, bool banked, uint32_t ticks, int32_t *codes)
+{ // the codes the envelopes leave after the ticks, from new envelopes as Envelope::Start leaves the
+    // segment it stopped in half played
+    Envelopes();
+    functimer0->Clear();
+    bank.Clear();
+    for (int8_t env = 0; env < count; env++)
+    {
+        envelopes[env]->Start();
+        if (banked)
+            bank.Start(bank.Add(envelopes[env]));
+        else
+            functimer0->Add(envelopes[env]);
+    }
+    if (banked)
+    {
+        CHECK(strstr(bank.print(), " 0 not added"));
+        functimer0->Add(&bank);
+    }
+    tickcpu = 0;
+    for (uint32_t i = 0; i < ticks; i++)
+    {
+        HostISR(callback(&Tick));
+        HostRun(TEST_TICK);
+    }
+    DACBusWait();
+    for (int8_t env = 0; env < count; env++)
+        codes[env] = (uint16_t)dacs[Envdac(env)].Getvoutdin();
+    functimer0->Clear();
+    bank.Clear();
+    for (int8_t env = 0; env < TEST_ENVS; env++)
+        delete envelopes[env];
+}
+
+static void TestBank(bool bench)
+{ // a tick of the arrays against a tick of the objects
+    static const int8_t counts[] = {16, 32, 64};
+    int32_t objects[TEST_ENVS], banked[TEST_ENVS];
+    uint32_t ticks = bench ? 20000 : 2000;
+    uint64_t objectcpu;
+    for (int8_t bus = 0; bus < NUMBERDACBUSES; bus++)
+        DACBUSES[bus]->SetAsync(true);
+    if (bench)
+        printf("Host CPU of a FuncTimer tick, %lu ticks\n", (long unsigned int)ticks);
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        Run(counts[i], false, ticks, objects);
+        objectcpu = tickcpu;
+        Run(counts[i], true, ticks, banked);
+        for (int8_t env = 0; env < counts[i]; env++)
+            CHECK(banked[env] == objects[env]);
+        if (bench)
+            printf("  %2d envelopes  objects %6.0f ns  EnvBank %6.0f ns, %5.1f million envelope ticks a second\n",
+                   counts[i], (double)objectcpu / ticks, (double)tickcpu / ticks,
+                   counts[i] * ticks * 1000.0 / tickcpu);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool bench = argc > 1 && !strcmp(argv[1], "bench");
+    HostBoard();
+    TestSegment(bench);
+    TestWave(bench);
+    TestBank(bench);
+    return (HostReport("test_envelope"));
+}
@@ -0,0 +1,240 @@
+// test_freq.cpp ... the frequency channels measuring the simulated VCOs
+//   the captures streaming to the DMA buffers, with prescaler changes and a flash stall lapping them
+//   the median rejecting glitches, and a VCO stopped for longer than a counter wrap
+//   the interrupt load of eight voices with FreqPoll reading the DMA and with the capture interrupts
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "board.h"
+#include "host.h"
+
+#define TEST_MS 1000000ULL // ns
+
+static void Play(int8_t voice, uint16_t code)
+{
+    dacs[VOICEBOARD[voice].dac].Voutprim(code);
+}
+
+static double Width(int8_t voice)
+{ // timer counts of the VCO's period now
+    HostVCO *vco = HostGetVCO(voice);
+    return (FREQUENCY / (VOICEBOARD[voice].lowfreq * pow(2.0, vco->pitch / VOICEBOARD[voice].dins_per_volt)));
+}
+
+static bool Near(uint32_t width, double expect, double tolerance)
+{
+    return (fabs(width - expect) <= expect * tolerance);
+}
+
+static uint32_t Watch(int8_t voice, uint64_t ns, double tolerance)
+{ // run, checking the voice's width after every poll, returns the widths which were off
+    uint32_t wrong = 0, samples = freqchannels[VOICEBOARD[voice].freq].Getsamples();
+    for (uint64_t t = 0; t < ns; t += TEST_MS)
+    {
+        HostRun(TEST_MS);
+        if (freqchannels[VOICEBOARD[voice].freq].Getsamples() != samples &&
+            !Near(freqchannels[VOICEBOARD[voice].freq].GetWidth(), Width(voice), tolerance))
+            wrong++;
+        samples = freqchannels[VOICEBOARD[voice].freq].Getsamples();
+    }
+    return (wrong);
+}
+
+static const uint16_t codes[NUMBERVCOS] = {32640, 6528, 13056, 45696, 52224, 58752, 39168, 26112};
+
+static void TestStream(bool bench)
+{ // eight VCOs on the DMA streams, no capture interrupts
+    uint32_t periods[NUMBERVCOS];
+    FreqChannel *channel;
+    CHECK(!(TIM2->DIER & (TIM_DIER_CC1IE | TIM_DIER_CC2IE | TIM_DIER_CC3IE | TIM_DIER_CC4IE)));
+    CHECK(!(TIM5->DIER & (TIM_DIER_CC1IE | TIM_DIER_CC2IE | TIM_DIER_CC3IE | TIM_DIER_CC4IE)));
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        Play(voice, codes[voice]);
+    HostRun(1000 * TEST_MS); // the first captures are 8 periods apart until Publish lowers the prescaler
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        periods[voice] = freqchannels[VOICEBOARD[voice].freq].Getperiods();
+    HostRun(1000 * TEST_MS);
+    if (bench)
+        printf("Eight VCOs on the DMA streams for a second\n");
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+    {
+        channel = &freqchannels[VOICEBOARD[voice].freq];
+        CHECK(fabs(channel->GetWidth() - Width(voice)) <= 1.0); // the stamps are exact, the average truncates
+        CHECK(fabs(channel->Getperiods() - periods[voice] - FREQUENCY / Width(voice)) <= 1 << 3); // a capture at most
+        if (bench)
+            printf("  voice %d %8.2f Hz width %8lu expected %10.1f periods %5lu %s\n", voice,
+                   FREQUENCY / Width(voice), (long unsigned int)channel->GetWidth(), Width(voice),
+                   (long unsigned int)(channel->Getperiods() - periods[voice]), channel->vars());
+    }
+    // up six octaves and back, Publish changes the prescaler and drops the old captures
+    Play(0, 58752);
+    HostRun(30 * TEST_MS); // the VCO settles
+    CHECK(!Watch(0, 200 * TEST_MS, 0.0001));
+    Play(0, 19584);
+    HostRun(30 * TEST_MS);
+    CHECK(!Watch(0, 200 * TEST_MS, 0.0001));
+    // a flash erase stalls the CPU long enough for the fastest channels to lap their buffers
+    Play(0, 58752);
+    HostRun(100 * TEST_MS);
+    HostStall(2000 * TEST_MS);
+    CHECK(!Watch(0, 500 * TEST_MS, 0.0001));
+    CHECK(!Watch(5, 100 * TEST_MS, 0.0001));
+}
+
+static void TestGlitch(bool bench)
+{ // every fifth period is half as long, the median ignores it and the average does not
+    FreqChannel *channel = &freqchannels[VOICEBOARD[1].freq];
+    uint32_t freq16;
+    uint8_t confidence;
+    double expect;
+    Play(1, 32640);
+    HostRun(500 * TEST_MS);
+    expect = FREQUENCY * 16.0 / Width(1);
+    HostGetVCO(1)->glitch = 5;
+    HostRun(100 * TEST_MS);
+    for (int8_t i = 0; i < 20; i++)
+    {
+        freq16 = channel->SampledFreq16(&confidence);
+        CHECK(fabs(freq16 - expect) <= 1); // 1/16 Hz
+        CHECK(confidence >= FREQ_MINCONFIDENCE);
+    }
+    CHECK(!Near(channel->Freq16(), expect, 0.05));
+    if (bench)
+        printf("440 Hz with every fifth period half, median %.2f Hz confidence %d%%, average %.2f Hz\n",
+               freq16 / 16.0, confidence, channel->Freq16() / 16.0);
+    HostGetVCO(1)->glitch = 0;
+}
+
+static void Gap(int8_t voice, bool bench)
+{ // the VCO stops and the counter wraps before its next capture, which a 32-bit difference would
+    // take for a period of a few milliseconds
+    int8_t timer = FREQBOARD[VOICEBOARD[voice].freq].timer;
+    FreqChannel *channel = &freqchannels[VOICEBOARD[voice].freq];
+    uint32_t periods;
+    double expect;
+    Play(voice, 32640);
+    HostRun(500 * TEST_MS);
+    HostGetVCO(voice)->running = false;
+    HostRun(20 * TEST_MS);
+    periods = channel->Getperiods();
+    HostSetcount(timer, HostGetcount(timer) + 0x100000000ULL - 1000000); // 40 s less 9 ms
+    HostRun(TEST_MS);
+    HostGetVCO(voice)->running = true;
+    CHECK(!Watch(voice, 200 * TEST_MS, 0.0001));
+    expect = 0.2 * FREQUENCY / Width(voice); // less the ones before the measurement restarts
+    CHECK(channel->Getperiods() - periods <= expect + 1 && channel->Getperiods() - periods + 8 >= expect);
+    if (bench)
+        printf("  voice %d %s, %lu periods in the 200 ms after the gap\n", voice,
+               channel->Getdma() ? "DMA" : "capture interrupts", (long unsigned int)(channel->Getperiods() - periods));
+}
+
+static void TestGap(bool bench)
+{ // the 64-bit stamps restart the measurement, TIM2's channels use the capture interrupts
+    for (int8_t i = 0; i < 4; i++)
+        freqchannels[i].Setdma(NULL, 0);
+    freqtimer0->start_action(FreqVoiced(0), FreqVoiced(1), FreqVoiced(2), FreqVoiced(3));
+    if (bench)
+        printf("A VCO stopped while its timer wraps\n");
+    Gap(2, bench);
+    Gap(4, bench);
+}
+
+static double Captures(void)
+{ // per second of the eight voices, Publish keeps each under FREQ_MAXCAPTURE with the prescaler
+    double captures = 0;
+    uint8_t psc;
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+    {
+        for (psc = 0; psc < FREQ_MAXPSC && Width(voice) * (1 << psc) < FREQUENCY / FREQ_MAXCAPTURE; psc++)
+            ;
+        captures += FREQUENCY / Width(voice) / (1 << psc);
+    }
+    return (captures);
+}
+
+static uint32_t pollcaptures;
+static uint64_t pollcpu, pollmax;
+
+static void Poll(void)
+{ // hostpoll's interrupt
+    uint32_t captures;
+    uint64_t cpu = HostCPU();
+    FreqPoll();
+    cpu = HostCPU() - cpu;
+    sscanf(FreqPollprint(), "FreqPoll captures %lu", (long unsigned int *)&captures);
+    pollcaptures += captures;
+    pollcpu += cpu;
+    pollmax = cpu > pollmax ? cpu : pollmax;
+}
+
+static void Widths(void)
+{
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        CHECK(fabs(freqchannels[VOICEBOARD[voice].freq].GetWidth() - Width(voice)) <= 1.0);
+}
+
+static void TestPoll(bool bench)
+{ // eight voices on the DMA streams are FREQ_POLLRATE interrupts a second whatever their pitch
+    uint32_t polls = bench ? 1000 : 100, irqs = HostIRQs(TIM2_IRQn, NULL) + HostIRQs(TIM5_IRQn, NULL);
+    double expect;
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        Play(voice, codes[voice]);
+    HostRun(1000 * TEST_MS);
+    hostpoll.detach();
+    expect = Captures() * polls / FREQ_POLLRATE;
+    pollcaptures = 0, pollcpu = 0, pollmax = 0;
+    for (uint32_t i = 0; i < polls; i++)
+    {
+        HostRun(1000 * TEST_MS / FREQ_POLLRATE);
+        HostISR(callback(&Poll));
+    }
+    irqs = HostIRQs(TIM2_IRQn, NULL) + HostIRQs(TIM5_IRQn, NULL) - irqs; // the overflows only
+    CHECK(fabs(pollcaptures - expect) <= NUMBERVCOS * 2);
+    CHECK(irqs <= polls / FREQ_POLLRATE * 2 / 39 + 2);
+    Widths();
+    if (bench)
+    {
+        printf("Eight voices, %.0f captures a second\n", Captures());
+        printf("  DMA         %5d interrupts a second, %6.0f ns host CPU per poll, %6.0f ns the slowest, %6.0f ns a second\n",
+               FREQ_POLLRATE, (double)pollcpu / polls, (double)pollmax, (double)pollcpu / polls * FREQ_POLLRATE);
+    }
+    hostpoll.attach_us(callback(FreqPoll), 1000000 / FREQ_POLLRATE);
+}
+
+static void TestInterrupts(bool bench)
+{ // with the capture interrupts each capture is an interrupt
+    uint32_t irqs, seconds = bench ? 10 : 1;
+    uint64_t cpu0, cpu1, cpu;
+    for (int8_t i = 0; i < NUMBERFREQS; i++)
+        freqchannels[i].Setdma(NULL, 0);
+    freqtimer0->start_action(FreqVoiced(0), FreqVoiced(1), FreqVoiced(2), FreqVoiced(3));
+    freqtimer1->start_action(FreqVoiced(4), FreqVoiced(5), FreqVoiced(6), FreqVoiced(7));
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        Play(voice, codes[voice]);
+    HostRun(1000 * TEST_MS);
+    irqs = HostIRQs(TIM2_IRQn, &cpu0) + HostIRQs(TIM5_IRQn, &cpu1);
+    cpu = cpu0 + cpu1;
+    HostRun(seconds * 1000 * TEST_MS);
+    irqs = HostIRQs(TIM2_IRQn, &cpu0) + HostIRQs(TIM5_IRQn, &cpu1) - irqs;
+    cpu = cpu0 + cpu1 - cpu;
+    // the captures of a timer's channels within one slice share an interrupt
+    CHECK(irqs / seconds <= Captures() + 2 && irqs / seconds >= Captures() * 9 / 10);
+    Widths();
+    if (bench)
+        printf("  interrupts  %5.0f interrupts a second, %6.0f ns host CPU per interrupt, %21s %6.0f ns a second\n",
+               (double)irqs / seconds, (double)cpu / irqs, "", (double)cpu / seconds);
+}
+
+int main(int argc, char **argv)
+{
+    bool bench = argc > 1 && !strcmp(argv[1], "bench");
+    HostBoard();
+    TestStream(bench);
+    TestPoll(bench);
+    TestGlitch(bench);
+    TestGap(bench);
+    TestInterrupts(bench);
+    return (HostReport("test_freq"));
+}
@@ -0,0 +1,195 @@
+// test_pitch.cpp ... the VCO's pitch math
+//   Getpitch's table against Getdinoffset and Dintowidth, and the time of each per Vout
+//   the ISR, a VCOAdj0 thread and a tuning thread calling the pitch math at the same time
+#include <pthread.h>
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "board.h"
+#include "host.h"
+
+#define TEST_TRITONES 21
+#define TEST_DINSTEP 97 // dins between the ones each caller checks
+#define TEST_DINS (0x10000 / TEST_DINSTEP + 1)
+
+static int16_t offsetsa[TEST_TRITONES], offsetsb[TEST_TRITONES];
+
+static void Offsets(void)
+{ // two sets of offsets as Autotune might leave them
+    for (int8_t tritone = 0; tritone < TEST_TRITONES; tritone++)
+    {
+        offsetsa[tritone] = 40 + tritone * 7 - (tritone * tritone) / 3;
+        offsetsb[tritone] = -30 + tritone * 11;
+    }
+}
+
+static void TestTable(bool bench)
+{ // the table lookup is within .005% or two counts of the VCO's period and replaces the divides in Vout.
+    // Dintowidth is limited by freq16's 1/16 Hz in the low octaves.
+    VCO *vco = &vcos[0];
+    Pitch pitch;
+    uint64_t start, table, divides;
+    uint32_t din, passes = bench ? 40 : 2;
+    volatile int32_t sink = 0;
+    int32_t worstoffset = 0, wrong = 0;
+    double worsttable, worstdivides, period, error;
+    vco->Setoffsets(offsetsa, TEST_TRITONES);
+    for (int8_t octave = 0; octave < VOICEBOARD[0].octaves; octave++)
+    {
+        worsttable = 0, worstdivides = 0;
+        for (din = octave * VOICEBOARD[0].dins_per_volt; din < (uint32_t)(octave + 1) * VOICEBOARD[0].dins_per_volt; din++)
+        {
+            pitch = vco->Getpitch(din);
+            if (abs(pitch.offset - vco->Getdinoffset(din)) > worstoffset)
+                worstoffset = abs(pitch.offset - vco->Getdinoffset(din));
+            period = FREQUENCY / (VOICEBOARD[0].lowfreq * pow(2.0, (double)din / VOICEBOARD[0].dins_per_volt));
+            error = fabs(pitch.widthfreq.width / period - 1.0);
+            worsttable = error > worsttable ? error : worsttable;
+            if (fabs(pitch.widthfreq.width - period) >= 2 && error >= 0.00005)
+                wrong++; // two counts, the table and the interpolation round, and .005%
+            error = fabs(vco->Dintowidth(din).width / period - 1.0);
+            worstdivides = error > worstdivides ? error : worstdivides;
+        }
+        if (bench)
+            printf("  octave %d period off by %.3f%% from Getpitch, %.3f%% from Dintowidth\n",
+                   octave, worsttable * 100, worstdivides * 100);
+    }
+    CHECK(worstoffset <= 1);
+    CHECK(!wrong);
+    start = HostCPU();
+    for (uint32_t pass = 0; pass < passes; pass++)
+        for (din = 0; din < 0x10000; din++)
+        {
+            pitch = vco->Getpitch(din);
+            sink += pitch.offset + pitch.widthfreq.width;
+        }
+    table = HostCPU() - start;
+    start = HostCPU();
+    for (uint32_t pass = 0; pass < passes; pass++)
+        for (din = 0; din < 0x10000; din++)
+            sink += vco->Getdinoffset(din) + vco->Dintowidth(din).width;
+    divides = HostCPU() - start;
+    if (bench)
+    {
+        printf("  pitch per Vout, every din %lu times, the offsets differ by %ld din at most\n",
+               (long unsigned int)passes, (long int)worstoffset);
+        printf("  Getpitch                   %6.1f ns\n", (double)table / passes / 0x10000);
+        printf("  Getdinoffset + Dintowidth  %6.1f ns\n", (double)divides / passes / 0x10000);
+    }
+}
+
+static Pitch pitcha[TEST_DINS], pitchb[TEST_DINS]; // Getpitch with offsetsa and offsetsb
+static WidthFreq widths[TEST_DINS];
+static uint32_t freqs[TEST_DINS];
+static int32_t dinsa[TEST_DINS];
+static volatile bool stressing;
+static volatile uint32_t isrs, isrmixed, isrwrong, callerwrong, callerpasses, swaps;
+
+static bool Samepitch(Pitch a, Pitch b)
+{
+    return (a.offset == b.offset && a.widthfreq.width == b.widthfreq.width &&
+            a.widthfreq.freq16 == b.widthfreq.freq16 && a.widthfreq.freq == b.widthfreq.freq);
+}
+
+static void Isr(void)
+{ // Vout's pitch for a sweep of dins, all of them from the old offsets or all from the new ones
+    VCO *vco = &vcos[0];
+    Pitch pitch;
+    int8_t set = 0; // 1 offsetsa, 2 offsetsb
+    for (uint32_t i = 0; i < TEST_DINS; i++)
+    {
+        pitch = vco->Getpitch(i * TEST_DINSTEP);
+        if (Samepitch(pitch, pitcha[i]) && Samepitch(pitch, pitchb[i]))
+            continue;
+        if (Samepitch(pitch, pitcha[i]))
+            isrmixed += set == 2, set = 1;
+        else if (Samepitch(pitch, pitchb[i]))
+            isrmixed += set == 1, set = 2;
+        else
+            isrwrong++;
+    }
+    isrs++;
+}
+
+static void *Isrs(void *arg)
+{ // the FuncTimer interrupts
+    while (stressing)
+        HostISR(callback(&Isr));
+    return (NULL);
+}
+
+static void *Caller(void *arg)
+{ // VCOAdj0 and the tuning threads, the offsets can change in the middle of a thread's Getpitch
+    VCO *vco = &vcos[0];
+    Pitch pitch;
+    WidthFreq widthfreq;
+    uint32_t din;
+    int16_t low, high;
+    while (stressing)
+    {
+        for (uint32_t i = 0; i < TEST_DINS; i++)
+        {
+            din = i * TEST_DINSTEP;
+            widthfreq = vco->Dintowidth(din);
+            pitch = vco->Getpitch(din);
+            low = pitcha[i].offset < pitchb[i].offset ? pitcha[i].offset : pitchb[i].offset;
+            high = pitcha[i].offset > pitchb[i].offset ? pitcha[i].offset : pitchb[i].offset;
+            if (widthfreq.width != widths[i].width || widthfreq.freq16 != widths[i].freq16 ||
+                vco->Dintofreq16(din) != freqs[i] || vco->Dinf(freqs[i]) != (uint32_t)dinsa[i] ||
+                pitch.widthfreq.width != pitcha[i].widthfreq.width || pitch.offset < low || pitch.offset > high)
+                callerwrong++;
+        }
+        callerpasses++;
+    }
+    return (NULL);
+}
+
+static void TestStress(bool bench)
+{ // a thread swaps the offsets while the ISR and two threads use the pitch math
+    VCO *vco = &vcos[0];
+    pthread_t isr, callers[2];
+    uint32_t rounds = bench ? 20000 : 2000;
+    vco->Setoffsets(offsetsb, TEST_TRITONES);
+    for (uint32_t i = 0; i < TEST_DINS; i++)
+        pitchb[i] = vco->Getpitch(i * TEST_DINSTEP);
+    vco->Setoffsets(offsetsa, TEST_TRITONES);
+    for (uint32_t i = 0; i < TEST_DINS; i++)
+    { // the single threaded reference
+        pitcha[i] = vco->Getpitch(i * TEST_DINSTEP);
+        widths[i] = vco->Dintowidth(i * TEST_DINSTEP);
+        freqs[i] = vco->Dintofreq16(i * TEST_DINSTEP);
+        dinsa[i] = vco->Dinf(freqs[i]);
+    }
+    stressing = true;
+    pthread_create(&isr, NULL, &Isrs, NULL);
+    pthread_create(&callers[0], NULL, &Caller, NULL);
+    pthread_create(&callers[1], NULL, &Caller, NULL);
+    for (swaps = 0; swaps < rounds || !isrs || callerpasses < 2; swaps++) // until the threads have run too
+        vco->Setoffsets(swaps & 1 ? offsetsa : offsetsb, TEST_TRITONES);
+    stressing = false;
+    pthread_join(isr, NULL);
+    pthread_join(callers[0], NULL);
+    pthread_join(callers[1], NULL);
+    CHECK(isrs > 0 && callerpasses > 0);
+    CHECK(!isrmixed);
+    CHECK(!isrwrong);
+    CHECK(!callerwrong);
+    if (bench)
+        printf("%lu offset swaps, %lu ISRs and %lu thread sweeps of %d dins, %lu mixed, %lu wrong\n",
+               (long unsigned int)swaps, (long unsigned int)isrs, (long unsigned int)callerpasses, TEST_DINS,
+               (long unsigned int)isrmixed, (long unsigned int)(isrwrong + callerwrong));
+}
+
+int main(int argc, char **argv)
+{
+    bool bench = argc > 1 && !strcmp(argv[1], "bench");
+    HostBoard();
+    if (bench)
+        printf("Getpitch against Getdinoffset and Dintowidth\n");
+    Offsets();
+    TestTable(bench);
+    TestStress(bench);
+    return (HostReport("test_pitch"));
+}
@@ -0,0 +1,202 @@
+// test_tune.cpp ... tuning the simulated VCOs
+//   a full retune by the Autotune engine against Tuneups one VCO at a time
+//   the model fit mode measuring a few tritones and filling the extreme octaves
+//   the PI controller in Adj holding a drifting VCO on its note
+//   Tuneup giving up a tritone whose periods never agree
+#include "mbed.h"
+#include "main.h"
+#include "freq.h"
+#include "vco.h"
+#include "dac.h"
+#include "dacbus.h"
+#include "autotune.h"
+#include "board.h"
+#include "host.h"
+
+#define TEST_MS 1000000ULL // ns
+#define TEST_TUNED 3       // dins, a tuned tritone is this close to the converter's error
+#define TEST_FITTED 6      // dins, a tritone the fit filled in
+
+static Autotune autotune;
+
+static void Converters(void)
+{ // every VCO is off in its own way, the high octaves roll off
+    HostVCO *vco;
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+    {
+        vco = HostGetVCO(voice);
+        vco->offset = 40.0 + voice * 15;
+        vco->scale = 3.0 - voice;
+        vco->rolloff = 60.0 + voice * 10;
+        vco->settle = 0.002;
+        vco->jitter = 20e-9;
+    }
+}
+
+static double Error(int8_t voice, int8_t tritone)
+{ // dins between the VCO's offset and the converter at the tritone's test voltage, 0 above the DAC
+    VCO *vco = VCOS[voice];
+    OctaveXstep ox = vco->Tritone(tritone);
+    int32_t code = vco->Dinx(ox.octave, ox.xstep) + vco->Getoffset(tritone);
+    if (code > 0xffff)
+        return (0.0);
+    return (vco->Getoffset(tritone) - HostError(voice, code));
+}
+
+static double Worst(int8_t first, int8_t last)
+{ // of all the voices
+    double worst = 0;
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        for (int8_t tritone = first; tritone <= last; tritone++)
+            worst = fabs(Error(voice, tritone)) > worst ? fabs(Error(voice, tritone)) : worst;
+    return (worst);
+}
+
+static double Extremes(void)
+{ // the octaves outside TUNE_FIRST to TUNE_LAST
+    double low = Worst(0, TUNE_FIRST - 1), high = Worst(TUNE_LAST + 1, VCOS[0]->Gettritones() - 1);
+    return (low > high ? low : high);
+}
+
+static uint32_t serialms, tunems;
+static double tunedextremes;
+
+static void TestAutotune(bool bench)
+{ // one engine settles every VCO's tritones together, each as soon as the widths agree
+    uint64_t start = HostNow();
+    double serialworst;
+    VCOS[0]->Tuneups(.02, false);
+    serialms = (HostNow() - start) / TEST_MS;
+    serialworst = 0;
+    for (int8_t tritone = TUNE_FIRST; tritone <= TUNE_LAST; tritone++)
+        serialworst = fabs(Error(0, tritone)) > serialworst ? fabs(Error(0, tritone)) : serialworst;
+    tunems = autotune.Run(false);
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+    {
+        CHECK(VCOS[voice]->Gettuned());
+        for (int8_t tritone = TUNE_FIRST; tritone <= TUNE_LAST; tritone++)
+            CHECK(fabs(Error(voice, tritone)) <= TEST_TUNED);
+    }
+    CHECK(tunems * 2 < serialms); // all of them in less than half the time of one
+    tunedextremes = Extremes();
+    if (bench)
+    {
+        printf("Tuning tritones %d to %d\n", TUNE_FIRST, TUNE_LAST);
+        printf("  Tuneups one VCO        %6lu ms, worst tuned tritone %.1f dins, the old threads ran one per VCO\n",
+               (long unsigned int)serialms, serialworst);
+        printf("  Autotune %d VCOs        %6lu ms, worst tuned tritone %.1f dins, %s", NUMBERVCOS,
+               (long unsigned int)tunems, Worst(TUNE_FIRST, TUNE_LAST), autotune.print());
+    }
+}
+
+static void TestFit(bool bench)
+{ // fewer tritones settle and the model beats copying the neighbours in the extreme octaves
+    uint32_t fitms = autotune.Run(false, true);
+    double extremes = Extremes();
+    for (int8_t voice = 0; voice < NUMBERVCOS; voice++)
+        for (int8_t tritone = 0; tritone < VCOS[voice]->Gettritones(); tritone++)
+            CHECK(fabs(Error(voice, tritone)) <= TEST_FITTED);
+    CHECK(fitms < tunems);
+    CHECK(extremes < tunedextremes);
+    if (bench)
+    {
+        printf("The model fit\n");
+        printf("  Autotune fit %d VCOs    %6lu ms, %s", NUMBERVCOS, (long unsigned int)fitms, autotune.print());
+        printf("  extreme octaves off by %.1f dins, %.1f dins when copied from the neighbours\n",
+               extremes, tunedextremes);
+    }
+}
+
+static double Cents(int8_t voice, int32_t din)
+{ // the VCO's pitch from the note's
+    return ((HostGetVCO(voice)->pitch - din) * 1200.0 / VOICEBOARD[voice].dins_per_volt);
+}
+
+static void Adjust(VCO *vco)
+{ // one pass of VCOAdj0
+    if (!vco->Getvcoadjsem()->wait(5000))
+        vco->Getdac()->Clradjusted();
+    FreqSample sample = vco->GetFreqChannel()->Median();
+    if (sample.confidence >= FREQ_MINCONFIDENCE)
+        vco->Getdac()->Adj(sample.width);
+}
+
+#define TEST_PIVOICE 3
+#define TEST_PIDIN 30000
+#define TEST_PIRATE 100 // Hz the pitch is sampled at
+
+static uint64_t pistart, piconverged;
+static uint32_t pisamples;
+static double piworst, pisquares;
+
+static void Sample(void)
+{ // a Ticker, the controller is judged by the pitch between its adjustments too
+    double cents = Cents(TEST_PIVOICE, TEST_PIDIN);
+    if (!piconverged && fabs(cents) <= 1.0)
+        piconverged = HostNow() - pistart;
+    if (HostNow() < pistart + 5000 * TEST_MS)
+        return;
+    piworst = fabs(cents) > piworst ? fabs(cents) : piworst; // the steady state
+    pisquares += cents * cents, pisamples++;
+}
+
+static void TestPI(bool bench)
+{ // the converter has drifted 10 cents since the tuning and keeps drifting
+    VCO *vco = VCOS[TEST_PIVOICE];
+    HostVCO *host = HostGetVCO(TEST_PIVOICE);
+    Ticker sampler;
+    uint64_t end;
+    uint32_t adjusts = 0;
+    double drift = 1.1; // dins per second
+    host->offset += 55.0 - drift * HostNow() * 1e-9; // 55 dins is 10 cents, the drift starts now
+    host->drift = drift;
+    HostRun(100 * TEST_MS);
+    while (vco->Getvcoadjsem()->wait(0))
+        ; // the wakeups of the tuning
+    vco->Getdac()->Vout(TEST_PIDIN, true); // the note
+    pistart = HostNow(), end = pistart + (bench ? 120000 : 30000) * TEST_MS;
+    piconverged = 0, piworst = 0, pisquares = 0, pisamples = 0;
+    sampler.attach_us(callback(&Sample), 1000000 / TEST_PIRATE);
+    while (HostNow() < end)
+    {
+        Adjust(vco);
+        adjusts++;
+    }
+    sampler.detach();
+    host->drift = 0;
+    CHECK(piconverged && piconverged < 200 * TEST_MS);
+    CHECK(piworst < 2.5); // the deadband and the drift in VCOAdj0's 5 seconds between checks
+    if (bench)
+        printf("PI pitch control of a note 10 cents flat, %.2f cents a second of drift\n"
+               "  within a cent after %.0f ms, then %.2f cents at worst %.2f cents rms, %lu wakeups\n",
+               drift * 1200 / VOICEBOARD[TEST_PIVOICE].dins_per_volt, piconverged / 1e6, piworst,
+               pisamples ? sqrt(pisquares / pisamples) : 0.0, (long unsigned int)adjusts);
+}
+
+static void TestNoisy(bool bench)
+{ // every sample is rejected, the tritone is given up after as many as Autotune tries
+    VCO *vco = VCOS[7];
+    HostVCO *host = HostGetVCO(7);
+    double jitter = host->jitter;
+    uint64_t start = HostNow();
+    host->jitter = 2e-3; // the periods are about 3 ms at TUNE_FIRST + 2
+    vco->Tuneup(TUNE_FIRST + 2, .02, false);
+    start = HostNow() - start;
+    CHECK(start < AUTOTUNE_TRIES * 100 * TEST_MS);
+    host->jitter = jitter;
+    if (bench)
+        printf("  a tritone of a noisy VCO given up after %.0f ms\n", start / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    bool bench = argc > 1 && !strcmp(argv[1], "bench");
+    Converters();
+    HostBoard();
+    HostRun(1000 * TEST_MS); // the frequency channels lower their prescalers
+    TestAutotune(bench);
+    TestFit(bench);
+    TestPI(bench);
+    TestNoisy(bench);
+    return (HostReport("test_tune"));
+}
@@ -35,87 +35,15 @@ DigitalOut myled(LED1);
 #include "freq.h"
 #include "vco.h"
 #include "dac.h"
+#include "dacbus.h"
 #include "adc.h"
 #include "envelope.h"
+#include "envbank.h"
 #include "functimer.h"
 #include "waves.h"
-
-// for these to work  copytargetchanges has modified .\mbed-os\targets\TARGET_STM\TARGET_STM32F7\TARGET_STM32F767xI\TARGET_NUCLEO_F767ZI\PeripheralPins.c:
-
-SPI spi1(PD_7, PG_9, PG_11); //SPI(MOSI, MISO, SCLK); -> DAC16-31 ok
-DigitalOut spi1_nss(PG_10);
-
-SPI spi2(PB_15, PB_14, PB_13); //SPI(MOSI, MISO, SCLK); -> ADC0-7 ok
-DigitalOut spi2_nss(PB_9);
-
-SPI spi3(PC_12, PC_11, PC_10); //SPI(MOSI, MISO, SCLK); -> ADC8-15 ok
-DigitalOut spi3_nss(PA_4);
-
-SPI spi4(PE_6, PE_5, PE_2); //SPI(MOSI, MISO, SCLK); -> DAC32-47 ok
-DigitalOut spi4_nss(PE_4);
-
-SPI spi5(PF_9, PF_8, PF_7); //SPI(MOSI, MISO, SCLK); -> DAC0-15 ok
-DigitalOut spi5_nss(PF_6);
-
-SPI spi6(PG_14, PG_12, PG_13, PG_8); //SPI(MOSI, MISO, SCLK); -> DAC48-63 ok
-DigitalOut spi6_nss(PG_8);
-
-voltspan span = {.low = -5, .high = 5};
-DigitalIn adc0_nbusy(PG_0, PullUp);
-
-LTC1859 a0(0, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a1(1, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a2(2, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a3(3, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a4(4, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a5(5, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a6(6, &spi2, &spi2_nss, &adc0_nbusy, span);
-LTC1859 a7(7, &spi2, &spi2_nss, &adc0_nbusy, span);
-
-DigitalIn adc1_nbusy(PG_1, PullUp);
-
-LTC1859 a8(8, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a9(9, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a10(10, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a11(11, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a12(12, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a13(13, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a14(14, &spi3, &spi3_nss, &adc1_nbusy, span);
-LTC1859 a15(15, &spi3, &spi3_nss, &adc1_nbusy, span);
-
-LTC2668 d0(0, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d1(1, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d2(2, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d3(3, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d4(4, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d5(5, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d6(6, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d7(7, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d8(8, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d9(9, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d10(10, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d11(11, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d12(12, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d13(13, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d14(14, &spi5, &spi5_nss, NULL, false, 9);
-LTC2668 d15(15, &spi5, &spi5_nss, NULL, false, 9);
-
-LTC2668 d16(16, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d17(17, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d18(18, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d19(19, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d20(20, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d21(21, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d22(22, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d23(23, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d24(24, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d25(25, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d26(26, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d27(27, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d28(28, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d29(29, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d30(30, &spi4, &spi4_nss, NULL, false, 9);
-LTC2668 d31(31, &spi4, &spi4_nss, NULL, false, 9);
+#include "board.h"
+#include "autotune.h"
+#include "calibration.h"
 
 // You can only attach static functions to NVIC_SetVector. Cannot use non-static member functions.  https://os.mbed.com/questions/69315/NVIC-Set-Vector-in-class/
 uint32_t irqcounter = 0;
@@ -137,16 +65,6 @@ static void IRQ2()
 FreqTimer t1(TIM5, RCC_APB1ENR_TIM5EN, TIM5_IRQn, (uint32_t)&IRQ2, PRESCALER, 1);
 FreqTimer *freqtimer1 = &t1;
 
-FreqChannel ch0(GPIOA, &t0, RCC_AHB1ENR_GPIOAEN, 15, 0, &TIM2->CCR1, 1);
-FreqChannel ch1(GPIOB, &t0, RCC_AHB1ENR_GPIOBEN, 3, 1, &TIM2->CCR2, 1);
-FreqChannel ch2(GPIOB, &t0, RCC_AHB1ENR_GPIOBEN, 10, 2, &TIM2->CCR3, 1);
-FreqChannel ch3(GPIOB, &t0, RCC_AHB1ENR_GPIOBEN, 11, 3, &TIM2->CCR4, 1);
-
-FreqChannel ch4(GPIOA, &t1, RCC_AHB1ENR_GPIOAEN, 0, 4, &TIM5->CCR1, 2);
-FreqChannel ch5(GPIOA, &t1, RCC_AHB1ENR_GPIOAEN, 1, 5, &TIM5->CCR2, 2);
-//FreqChannel ch6(GPIOA, &t1, RCC_AHB1ENR_GPIOAEN,  2, 6, &TIM5->CCR3, 2);
-//FreqChannel ch7(GPIOA, &t1, RCC_AHB1ENR_GPIOAEN,  3, 7, &TIM5->CCR4, 2);
-
 volatile static uint32_t funccounter0 = 0;
 
 static void FIRQ0()
@@ -213,63 +131,80 @@ void IRQBlinker(void)
 
 Thread IRQBlinkerThread;
 
-void SetupSPIs(void)
-{
-    // DAC16-31
-    spi1_nss = 1;
-    spi1.format(8, 0);
-    spi1.frequency(5000000);
-    // ADC0-7
-    spi2_nss = 1;
-    spi2.format(8, 0);
-    spi2.frequency(5000000);
-    // ADC8-15
-    spi3_nss = 1;
-    spi3.format(8, 0);
-    spi3.frequency(5000000);
-    // DAC32-47
-    spi4_nss = 1;
-    spi4.format(8, 0);
-    spi4.frequency(5000000);
-    // DAC0-15
-    spi5_nss = 1;
-    spi5.format(8, 0);
-    spi5.frequency(5000000);
-    // DAC48-63
-    spi6_nss = 1;
-    spi6.format(8, 0);
-    spi6.frequency(5000000);
+Ticker freqpoll;
+Autotune autotune;
+Calibration calibration;
+Thread calthread;
+volatile bool calchecking; // Calcheck has the VCO DACs, ft0 stays stopped until it returns
+Retune retune(&autotune);
+Thread retunethread;
+
+bool Calsave(void)
+{ // erasing the flash sector stalls the interrupts for about a second, so the timers are stopped
+    bool running0 = ft0.Running(), running1 = ft1.Running(), saved;
+    ft0.Stop();
+    ft1.Stop();
+    saved = calibration.Save();
+    if (running0)
+        ft0.Start();
+    if (running1)
+        ft1.Start();
+    return (saved);
 }
 
-void Tuneups0(void) { VCOS[0]->Tuneups(.02, false); }
-void Tuneups1(void) { VCOS[1]->Tuneups(.02, false); }
-void Tuneups2(void) { VCOS[2]->Tuneups(.02, false); }
-void Tuneups3(void) { VCOS[3]->Tuneups(.02, false); }
-void Tuneups4(void) { VCOS[4]->Tuneups(.02, false); }
-void Tuneups5(void) { VCOS[5]->Tuneups(.02, false); }
-Envelope env0 = Envelope(0, &d0, true, false);
-Envelope env1 = Envelope(1, &d1, true, false);
-Envelope env2 = Envelope(2, &d2, true, false);
-Envelope env3 = Envelope(3, &d3, true, false);
-Envelope env4 = Envelope(4, &d4, true, false);
-Envelope env5 = Envelope(5, &d5, true, false);
-void Env0SegChange(void) { env0.IncSegChange(); }
-void Env1SegChange(void) { env1.IncSegChange(); }
-void Env2SegChange(void) { env2.IncSegChange(); }
-void Env3SegChange(void) { env3.IncSegChange(); }
-void Env4SegChange(void) { env4.IncSegChange(); }
-void Env5SegChange(void) { env5.IncSegChange(); }
+void Calcheck(void)
+{ // spot-check the calibration loaded at boot, retune every VCO if one has drifted
+    // env0-5 drive the VCO DACs, so ft0 is stopped while they are measured
+    bool retune = false, running = ft0.Running();
+    ft0.Stop();
+    for (int i = 0; i < NUMBERVCOS; i++)
+    {
+        if (VCOS[i] && VCOS[i]->Gettuned() && !calibration.Check(VCOS[i]))
+        {
+            printf("VCO %d drifted from its calibration\n\r", i);
+            retune = true;
+        }
+    }
+    if (retune)
+    { // a drifted VCO keeps its shape, the model fit retunes it with a few measurements
+        autotune.Run(false, true);
+        printf("%s", autotune.print());
+        printf("Retuned, menu 's' saves the calibration\n\r"); // not while the instrument may be played
+    }
+    calchecking = false;
+    if (running)
+        ft0.Start();
+}
+
+void ft0Start(void)
+{ // the menu waits for the spot-check of the calibration
+    while (calchecking)
+        wait(.1);
+    ft0.Start();
+}
+Envelope env0 = Envelope(0, &dacs[0], true, false);
+Envelope env1 = Envelope(1, &dacs[1], true, false);
+Envelope env2 = Envelope(2, &dacs[2], true, false);
+Envelope env3 = Envelope(3, &dacs[3], true, false);
+Envelope env4 = Envelope(4, &dacs[4], true, false);
+Envelope env5 = Envelope(5, &dacs[5], true, false);
+EnvBank envbank;
 
 // VCAs instead of using the Adsr class use the wave tables in the DAC class
-//Adsr adsr0 = Adsr(0, &d6, false, false);
-//d6.Setwave(&Waves::vca[0], 0);
-//Adsr adsr1 = Adsr(1, &d10, false, false);
-//d10.Setwave(&Waves::vca[0], 0);
+//Adsr adsr0 = Adsr(0, &dacs[6], false, false);
+//dacs[6].Setwave(vcabank.Get(0));
+//Adsr adsr1 = Adsr(1, &dacs[10], false, false);
+//dacs[10].Setwave(vcabank.Get(0));
 // VCFs
-//Adsr adsr2 = Adsr(2, &d7, false, false);
-//d7.Setwave(&Waves::vcf[0], 0);
-//Adsr adsr3 = Adsr(3, &d11, false, false);
-//d11.Setwave(&Waves::vcf[0], 0);
+//Adsr adsr2 = Adsr(2, &dacs[7], false, false);
+//dacs[7].Setwave(vcfbank.Get(0));
+//Adsr adsr3 = Adsr(3, &dacs[11], false, false);
+//dacs[11].Setwave(vcfbank.Get(0));
+
+uint32_t Velocityrate(int velocity)
+{ // harder notes play the VCA and VCF waves faster, velocity 64 is the original speed
+    return ((WAVERATE_ONE >> 1) + ((uint32_t)velocity * WAVERATE_ONE) / 128);
+}
 
 void show_message(MIDIMessage msg)
 {
@@ -280,37 +215,44 @@ void show_message(MIDIMessage msg)
         //printf("NoteOn key:%d, velocity: %d, channel: %d\n\r", msg.key(), msg.velocity(), msg.channel());
         if (msg.channel() < NUMBERVCOS)
         {
+            VCOS[msg.channel()]->Setgate(true); // before the output so Retune sees the voice is taken
             VCOS[msg.channel()]->Getdac()->Vmidi(msg.key());
             if (msg.channel() == 0)
             {
-                d6.Start();
+                dacs[6].Setrate(Velocityrate(msg.velocity()));
+                dacs[7].Setrate(Velocityrate(msg.velocity()));
+                dacs[6].Start();
                 //ADSRS[0]->Restart();
-                d7.Start();
+                dacs[7].Start();
                 //ADSRS[2]->Restart();
             }
             else if (msg.channel() == 1)
             {
-                d10.Start();
+                dacs[10].Setrate(Velocityrate(msg.velocity()));
+                dacs[11].Setrate(Velocityrate(msg.velocity()));
+                dacs[10].Start();
                 //ADSRS[1]->Restart();
-                d11.Start();
+                dacs[11].Start();
                 //ADSRS[3]->Restart();
             }
         }
         break;
     case MIDIMessage::NoteOffType:
         //printf("NoteOff key:%d, velocity: %d, channel: %d\n\r", msg.key(), msg.velocity(), msg.channel());
+        if (msg.channel() < NUMBERVCOS)
+            VCOS[msg.channel()]->Setgate(false);
         if (msg.channel() == 0)
         {
-            d6.Release();
+            dacs[6].Release();
             //ADSRS[0]->Release();
-            d7.Release();
+            dacs[7].Release();
             //ADSRS[2]->Release();
         }
         if (msg.channel() == 1)
         {
-            d10.Release();
+            dacs[10].Release();
             //ADSRS[1]->Release();
-            d11.Release();
+            dacs[11].Release();
             //ADSRS[3]->Release();
         }
         break;
@@ -326,24 +268,47 @@ void show_message(MIDIMessage msg)
     }
 }
 
+uint32_t Voctall(const int8_t *octaves, const int8_t *halfsteps)
+{ // the VCOs change together, each chip gets one "update all" after its codes are staged
+    // The buses are held while the batch is built and then all four send in parallel.
+    bool commit[NUMBERDACBUSES] = {false};
+    DACBusHold();
+    for (int i = 0; i < NUMBERVCOS; i++)
+        VCOS[i]->Getdac()->Begin();
+    for (int i = 0; i < NUMBERVCOS; i++)
+        VCOS[i]->Getdac()->Voct(octaves[i], halfsteps[i]);
+    for (int i = 0; i < NUMBERVCOS; i++)
+    {
+        int8_t bus = VCOS[i]->Getdac()->m_dacnum >> 4;
+        if (commit[bus])
+        {
+            VCOS[i]->Getdac()->End();
+        }
+        else
+        {
+            commit[bus] = true;
+            VCOS[i]->Getdac()->Commit();
+        }
+    }
+    DACBusFlush();
+    return (DACBusWait()); // microseconds for the slowest bus
+}
+
 void Triads(int8_t octave)
 {
-    DACS[0]->Voct(octave, 0);
-    DACS[1]->Voct(octave, 4);
-    DACS[2]->Voct(octave, 7);
-    DACS[3]->Voct(octave + 1, 0);
-    DACS[4]->Voct(octave + 1, 4);
-    DACS[5]->Voct(octave + 1, 7);
+    static const int8_t triad[3] = {0, 4, 7};
+    int8_t octaves[NUMBERVCOS], halfsteps[NUMBERVCOS];
+    for (int i = 0; i < NUMBERVCOS; i++) // a major triad, the next voices an octave up
+        octaves[i] = octave + i / 3, halfsteps[i] = triad[i % 3];
+    Voctall(octaves, halfsteps);
 }
 
 void Octaves(void)
 {
-    DACS[0]->Voct(2, 0);
-    DACS[1]->Voct(3, 0);
-    DACS[2]->Voct(4, 0);
-    DACS[3]->Voct(5, 0);
-    DACS[4]->Voct(6, 0);
-    DACS[5]->Voct(7, 0);
+    int8_t octaves[NUMBERVCOS], halfsteps[NUMBERVCOS];
+    for (int i = 0; i < NUMBERVCOS; i++)
+        octaves[i] = 2 + i, halfsteps[i] = 0;
+    Voctall(octaves, halfsteps);
 }
 
 void VCFSet(void)
@@ -463,7 +428,10 @@ void ft0Set(void)
 int main()
 {
     int c = 0, cnt = 0, ai;
+    SegCurve curve = CurveLinear;
+    int banksize = ENVBANK_SIZE;
     uint32_t fcnt;
+    SetupBoard();
     pc.baud(115200);
     fclose(stdout);
     stdout = pc;
@@ -491,22 +459,16 @@ int main()
     printf("dac_nclr is high\r\n");
 
     SetupSPIs();
-    voltspan span = {.low = -5, .high = 5};
     for (int i = 0; i < NUMBERDACS; i++)
     {
         if (DACS[i])
         {
-            DACS[i]->Setspan(span);
+            DACS[i]->Setspan(DACBOARD[i].span);
             DACS[i]->Vchk(6528 * (i % 8));
         }
     }
 
-    VCO v0(&ch0, &d0, 0, 13.75, -5.0, 10, 6528, 1, &VCOAdj0);
-    VCO v1(&ch1, &d1, 1, 13.75, -5.0, 10, 6528, 1, &VCOAdj0);
-    VCO v2(&ch2, &d2, 2, 13.75, -5.0, 10, 6528, 1, &VCOAdj0);
-    VCO v3(&ch3, &d3, 3, 13.75, -5.0, 10, 6528, 1, &VCOAdj0);
-    VCO v4(&ch4, &d4, 4, 13.75, -5.0, 10, 6528, 1, &VCOAdj0);
-    VCO v5(&ch5, &d5, 5, 13.75, -5.0, 10, 6528, 1, &VCOAdj0);
+    SetupVoices();
     //for (int i=0; i<NUMBERVCOS; i++) if (VCOS[i]) VCOS[i]->StartAdj();
 
     printf("%s", t0.print());
@@ -522,35 +484,41 @@ int main()
     timerdump(TIM5);
 
     c = getchar("start t0");
-    //            ch0 1 2 3
-    t0.start_action(1, 1, 1, 1);
-    d0.Setwave(&Waves::vca[0], 0);
-    d0.Dumpwave();
-    d0.Nexts();
-    d0.Setwave(&Waves::vca[0], 1);
-    d0.Dumpwave();
-    d0.Nexts();
-    d0.Setwave(&Waves::vca[0], 2);
-    d0.Dumpwave();
-    d0.Nexts();
+    t0.start_dma(FreqVoiced(0), FreqVoiced(1), FreqVoiced(2), FreqVoiced(3)); // the captures stream to DMA and FreqPoll reads them
+    freqpoll.attach_us(callback(FreqPoll), 1000000 / FREQ_POLLRATE);
+    dacs[0].Setwave(vcabank.Get(0));
+    dacs[0].Dumpwave();
+    dacs[0].Nexts();
+    dacs[0].Setwave(vcabank.Get(1));
+    dacs[0].Dumpwave();
+    dacs[0].Nexts();
+    dacs[0].Setwave(vcabank.Get(2));
+    dacs[0].Dumpwave();
+    dacs[0].Nexts();
 
     c = getchar("start t1");
-    //            ch4 5 6 7
-    t1.start_action(1, 1, 0, 0);
+    t1.start_dma(FreqVoiced(4), FreqVoiced(5), FreqVoiced(6), FreqVoiced(7));
+    if (calibration.Load()) // the VCOs are tuned now, the spot-check needs the frequency timers
+    {
+        calchecking = true; // before the thread runs, the menu may start ft0 first
+        calthread.start(callback(Calcheck));
+    }
+    printf("%s", calibration.print());
+    retunethread.start(callback(&retune, &Retune::Run)); // idle voices are retuned while playing
 
     c = getchar("envelopes ft0");
     ft0Set();
     //VCA ADSRs
     ft1.Clear();
-    ft1.Add(&d6); // this is a VCA ADSR
-    d6.Setwave(&Waves::vca[0], 0);
-    ft1.Add(&d10); // this is a VCA ADSR
-    d10.Setwave(&Waves::vca[0], 0);
+    ft1.Add(&dacs[6]); // this is a VCA ADSR
+    dacs[6].Setwave(vcabank.Get(0));
+    ft1.Add(&dacs[10]); // this is a VCA ADSR
+    dacs[10].Setwave(vcabank.Get(0));
     //VCF ADSRs
-    ft1.Add(&d7); // this is a VCA ADSR
-    d7.Setwave(&Waves::vcf[0], 0);
-    ft1.Add(&d11); // this is a VCA ADSR
-    d11.Setwave(&Waves::vcf[0], 0);
+    ft1.Add(&dacs[7]); // this is a VCA ADSR
+    dacs[7].Setwave(vcfbank.Get(0));
+    ft1.Add(&dacs[11]); // this is a VCA ADSR
+    dacs[11].Setwave(vcfbank.Get(0));
     printf("\n\rENVS\n\r");
     for (int i = 0; i < NUMBERENVS; i++)
         if (ENVS[i])
@@ -582,12 +550,12 @@ int main()
             {
                 timer.start();
                 wait(0.1);
-                d0.Voct(3, 0 + cnt % 12);
-                d1.Voct(3, 4 + cnt % 12);
-                d2.Voct(3, 7 + cnt % 12);
-                d3.Voct(4, 0 + cnt % 12);
-                d4.Voct(4, 4 + cnt % 12);
-                d5.Voct(4, 7 + cnt % 12);
+                dacs[0].Voct(3, 0 + cnt % 12);
+                dacs[1].Voct(3, 4 + cnt % 12);
+                dacs[2].Voct(3, 7 + cnt % 12);
+                dacs[3].Voct(4, 0 + cnt % 12);
+                dacs[4].Voct(4, 4 + cnt % 12);
+                dacs[5].Voct(4, 7 + cnt % 12);
                 cnt++;
                 wait(0.5);
                 printf("%8.1f: ovl %4d,%12d %12d,%12d\n\r", (float)timer.read_ms() / 1000.0, t0.overflow(), t0.timercount(), t1.overflow(), t1.timercount());
@@ -597,29 +565,13 @@ int main()
                 myled = !myled;
             }
         }
-        if (c == 0x31)
+        if (c == 0x31 || c == 'm') // 'm' measures a few tritones and fits the model to them
         {
             ft0.Stop();
             //for (int i=0; i<NUMBERVCOS; i++) if (VCOS[i]) VCOS[i]->Tuneups(.02, false);
-            Thread thread0;
-            thread0.start(callback(Tuneups0));
-            Thread thread1;
-            thread1.start(callback(Tuneups1));
-            Thread thread2;
-            thread2.start(callback(Tuneups2));
-            Thread thread3;
-            thread3.start(callback(Tuneups3));
-            Thread thread4;
-            thread4.start(callback(Tuneups4));
-            Thread thread5;
-            thread5.start(callback(Tuneups5));
-            //print_all_thread_info();
-            printf("thread0 %d\n\r", thread0.join());
-            printf("thread1 %d\n\r", thread1.join());
-            printf("thread2 %d\n\r", thread2.join());
-            printf("thread3 %d\n\r", thread3.join());
-            printf("thread4 %d\n\r", thread4.join());
-            printf("thread5 %d\n\r", thread5.join());
+            autotune.Run(false, c == 'm');
+            printf("%s", autotune.print());
+            printf("Calibration saved %d\n\r", Calsave());
             for (int i = 0; i < NUMBERVCOS; i++)
             {
                 if (VCOS[i])
@@ -634,6 +586,9 @@ int main()
         {
             ft0.Stop();
             Triads(3);
+            for (int i = 0; i < NUMBERDACBUSES; i++)
+                if (DACBUSES[i])
+                    printf("%s", DACBUSES[i]->print());
             for (int i = 0; i < 2; i++)
             {
                 printf("\n\r");
@@ -641,6 +596,18 @@ int main()
                     if (VCOS[i])
                         VCOS[i]->MiniDump();
             }
+            for (int i = 0; i < NUMBERFREQS; i++)
+                if (FREQS[i])
+                    printf("%s\n\r", FREQS[i]->vars());
+            printf("%s", FreqPollprint());
+            printf("%s", retune.print());
+        }
+        if (c == 's') // save the calibration, the envelopes and waves stop while the flash is erased
+            printf("Calibration saved %d\n\r", Calsave());
+        if (c == 'h') // background retuning of idle voices on or off
+        {
+            retune.Enable(!retune.Getenabled());
+            printf("%s", retune.print());
         }
         if (c == 0x33)
         {
@@ -651,10 +618,10 @@ int main()
         }
         if (c == 0x34)
         {
-            //printf("A0 busy %d\n\r", a0.Busy());
+            //printf("A0 busy %d\n\r", adcs[0].Busy());
             //a0.Vchk();
-            printf("A0 busy %d\n\r", a0.Busy());
-            printf("A8 busy %d\n\r", a8.Busy());
+            printf("A0 busy %d\n\r", adcs[0].Busy());
+            printf("A8 busy %d\n\r", adcs[8].Busy());
             for (int i = 0; i < NUMBERADCS; i++)
                 if (ADCS[i])
                     ADCS[i]->Vchk();
@@ -681,7 +648,7 @@ int main()
             //rtostimer.start(40);
             //ticks = 0;
             ft0Set();
-            ft0.Start();
+            ft0Start();
             while (1)
             {
                 c = getchar("Quit or n(-1) or p(+1) or r(repl)");
@@ -723,21 +690,33 @@ int main()
                 case 'k':
                     ft0.IncReload(-ai * 10);
                     break;
-                case 'x':
-                    env0.SetSegFunc(Env0SegChange);
-                    env1.SetSegFunc(Env1SegChange);
-                    env2.SetSegFunc(Env2SegChange);
-                    env3.SetSegFunc(Env3SegChange);
-                    env4.SetSegFunc(Env4SegChange);
-                    env5.SetSegFunc(Env5SegChange);
+                case 'x': // the next curve for every segment, a table lookup per tick instead of a callback
+                    curve = (SegCurve)((curve + 1) % NUMBERCURVES);
+                    for (ai = 0; ai < 6; ai++)
+                        ENVS[ai]->SetCurve(curve);
+                    printf("curve %d\n\r", curve);
+                    break;
+                case 'b': // blocking SPI writes in the ISR, compare the cycles in ft0.print()
+                case 'f': // queued frames sent after each tick
+                    for (ai = 0; ai < NUMBERDACBUSES; ai++)
+                        if (DACBUSES[ai])
+                            DACBUSES[ai]->SetAsync(c == 'f');
+                    printf("%s", ft0.print());
+                    break;
+                case 'v': // the envelopes run from the EnvBank arrays, 6 then 16, 32 and 64 copies, compare the cycles in ft0.print()
+                    banksize = banksize >= ENVBANK_SIZE ? 6 : banksize < 16 ? 16 : banksize * 2;
+                    ft0.Stop();
+                    ft0.Clear();
+                    envbank.Clear();
+                    for (ai = 0; ai < banksize; ai++)
+                        envbank.Start(envbank.Add(ENVS[ai % 6]));
+                    ft0.Add(&envbank);
+                    ft0Start();
+                    wait(1);
+                    printf("%s%s", envbank.print(), ft0.print());
                     break;
                 case 'y':
-                    env0.SetSegFunc(NULL);
-                    env1.SetSegFunc(NULL);
-                    env2.SetSegFunc(NULL);
-                    env3.SetSegFunc(NULL);
-                    env4.SetSegFunc(NULL);
-                    env5.SetSegFunc(NULL);
+                    curve = CurveLinear;
                     ft0Set();
                     break;
                 default:
@@ -752,6 +731,9 @@ int main()
             fcnt = funccounter0;
             printf("%d %s", funccounter0, ft0.print());
             printf("funccounter0 %d\n\r", fcnt);
+            for (ai = 0; ai < NUMBERDACBUSES; ai++)
+                if (DACBUSES[ai])
+                    printf("%s", DACBUSES[ai]->print());
         }
         if (c == 0x38)
         {
@@ -797,6 +779,19 @@ int main()
                 }
             }
         }
+        if (c == 't')
+        {
+            ft0.Stop();
+            ft0.Clear();
+            dacs[0].Settoggle(VCOS[0]->Dinh(4, 0), VCOS[0]->Dinh(4, 2)); // trill a whole step
+            ft0.AddToggle(dacs[0].GetBus(), 1);
+            ft0Start();
+            c = getchar("Trill ... Quit");
+            ft0.Stop();
+            ft0.Clear();
+            dacs[0].Cleartoggle();
+            dacs[0].Voct(4, 0);
+        }
         if (c == 'a')
         {
             ft0.Stop();
@@ -809,19 +804,19 @@ int main()
                 if (c == 'q')
                     break;
                 ai = (c < 0x30 || c > 0x37) ? 0x30 : c - 0x30;
-                d6.Setwave(&Waves::vca[0], ai);
-                d7.Setwave(&Waves::vcf[0], ai);
-                d10.Setwave(&Waves::vca[0], ai);
-                d11.Setwave(&Waves::vcf[0], ai);
-                d6.Start();
-                d7.Start();
+                dacs[6].Setwave(vcabank.Get(ai));
+                dacs[7].Setwave(vcfbank.Get(ai));
+                dacs[10].Setwave(vcabank.Get(ai));
+                dacs[11].Setwave(vcfbank.Get(ai));
+                dacs[6].Start();
+                dacs[7].Start();
                 //while(!adsr0.Next()) wait(.01);
                 //printf("\n\rm_segcnt %d\n\r", adsr0.m_segcnt);
                 c = getchar("Release, Quit or Dump");
                 if (c == 'q')
                     break;
-                d6.Release();
-                d7.Release();
+                dacs[6].Release();
+                dacs[7].Release();
                 if (c == 'd')
                 {
                     print_all_thread_info();
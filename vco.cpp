@@ -6,6 +6,7 @@
 #include "freq.h"
 #include "vco.h"
 #include "dac.h"
+#include "autotune.h"
 
 // 1 Volt per octave.  12*34=408 digital input counts per volt.
 // 4080=10 volts.  For 12-bit DAC with 4095 (0xfff) steps. Highest value is 10.036 volts.
@@ -22,7 +23,30 @@
 // 9   18       +4  7040     3672
 // 10  20       +5  14080    3672
 
-VCOPtr *VCOS = new VCOPtr[NUMBERVCOS]();
+VCOPtr VCOS[NUMBERVCOS];
+
+int32_t Xlog2(uint32_t value, int8_t qbits)
+{ // log2(value / 2**qbits) in 1/256 xsteps.  The value is normalized to 2**15 to 2**16 and found by a
+    // binary search of XSTEPMULS, the remainder is interpolated to the next entry.
+    int8_t msb;
+    uint32_t mantissa, lo, hi;
+    int16_t low = 0, high = XSTEPS_PER_OCTAVE - 1, mid;
+    if (!value)
+        return (INT32_MIN);
+    msb = 31 - __builtin_clz(value);
+    mantissa = msb >= HALFSTEPPWR ? value >> (msb - HALFSTEPPWR) : value << (HALFSTEPPWR - msb);
+    while (low < high)
+    { // the last xstep whose multiplier is not above the mantissa
+        mid = (low + high + 1) >> 1;
+        if (XSTEPMULS[mid] <= mantissa)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    lo = XSTEPMULS[low];
+    hi = low < XSTEPS_PER_OCTAVE - 1 ? XSTEPMULS[low + 1] : 1 << (HALFSTEPPWR + 1);
+    return (((msb - qbits) * XSTEPS_PER_OCTAVE + low) << XLOGPWR) + (int32_t)(((mantissa - lo) << XLOGPWR) / (hi - lo));
+}
 
 // This is the method use by VCO's m_thread.  The method must be static so is defined here instead of in the Object.
 void VCOAdj0(VCO *vco)
@@ -37,14 +61,28 @@ void VCOAdj0(VCO *vco)
         //if(semaphoreid == 0) vco->Getdac()->Reset();
         if (semaphoreid == 0)
             vco->Getdac()->Clradjusted();
-        vco->Getdac()->Adj(vco->GetFreqChannel()->GetWidth());
+        if (vco->Getretuning())
+            continue; // the output is a Retune test voltage
+        FreqSample sample = vco->GetFreqChannel()->Median();
+        if (sample.confidence >= FREQ_MINCONFIDENCE) // a glitch does not move the pitch
+            vco->Getdac()->Adj(sample.width);
     }
 }
 
+VCO::VCO(void)
+{
+    m_halfsteps = 0;
+}
+
 VCO::VCO(FreqChannel *freqchannel, LTC2668 *dac, int8_t vconum, float lowfreq, float lowvolts,
          int8_t octaves, int16_t dins_per_volt, int16_t octaves_per_volt, vcoadjtype vcoadjfunc)
 {
-    m_buf = (char *)malloc(140);
+    Init(freqchannel, dac, vconum, lowfreq, lowvolts, octaves, dins_per_volt, octaves_per_volt, vcoadjfunc);
+}
+
+void VCO::Init(FreqChannel *freqchannel, LTC2668 *dac, int8_t vconum, float lowfreq, float lowvolts,
+               int8_t octaves, int16_t dins_per_volt, int16_t octaves_per_volt, vcoadjtype vcoadjfunc)
+{
     m_vcoadjfunc = vcoadjfunc;
     m_dac = dac;
     m_dac->SetVCO(this);
@@ -53,23 +91,34 @@ VCO::VCO(FreqChannel *freqchannel, LTC2668 *dac, int8_t vconum, float lowfreq, f
     m_vconum = vconum;
     m_lowfreq = lowfreq;
     m_lowvolts = lowvolts;
-    m_octaves = octaves;
+    m_octaves = octaves > NUMBEROCTAVES ? NUMBEROCTAVES : octaves;
     m_dins_per_volt = dins_per_volt;
     m_octaves_per_volt = octaves_per_volt;
-    m_dinmod = 0, m_din = 0;
-    m_tritone = 0;
+    m_halfsteps = 0; // Clr leaves m_pitches alone until it is filled in below
+    m_tunevout = 0;
+    m_vca = NULL, m_gate = false, m_retuning = false;
     m_dins_per_halfstep = int16_t((m_octaves_per_volt * m_dins_per_volt) / HALFSTEPS_PER_OCTAVE);
-    //m_offsets = new int16_t[m_octaves*2+1]; // Each tritone has a different offset
-    m_offsets = (int16_t *)malloc((m_octaves * 2 + 1) * 2); // Each tritone has a different offset
     Clr();
-    m_hmul = 0, m_omul = 0, m_freq = 0;
-    //m_octavemuls = new int16_t[m_octaves+1]; // multipliers for the halfsteps
-    m_octavemuls = (int16_t *)malloc((m_octaves + 1) * 2); // multipliers for the halfsteps
     for (int octave = 0; octave < (m_octaves + 1); octave++)
     {
         m_octavemuls[octave] = round(m_lowfreq * pow(2, octave) * pow(2, OCTAVEPWR));
     };
-    Semaphore m_vcoadjsem(0);
+    // The target periods do not change so only the offsets are rebuilt when they change.  One more
+    // halfstep than the octaves cover so Getpitch always has a point above the din.  The periods are
+    // worked out in floating point here, Getwidth's freq16 is only 1/16 Hz in the low octaves.
+    m_halfsteps = m_octaves * HALFSTEPS_PER_OCTAVE + 2;
+    m_halfsteprecip = ((1 << PITCHSHIFT) + m_dins_per_halfstep - 1) / m_dins_per_halfstep;
+    m_lowxlog = Xlog2((uint32_t)(m_lowfreq * 16 * (1 << 16) + .5), 16);
+    m_xlogtodin = (uint32_t)(((uint64_t)m_dins_per_volt << 32) / ((uint32_t)XSTEPS_PER_OCTAVE << XLOGPWR));
+    for (int16_t halfstep = 0; halfstep < m_halfsteps; halfstep++)
+    {
+        int16_t top = halfstep > m_octaves * HALFSTEPS_PER_OCTAVE ? m_octaves * HALFSTEPS_PER_OCTAVE : halfstep;
+        float freq = m_lowfreq * pow(2, (float)top / HALFSTEPS_PER_OCTAVE);
+        m_pitches[halfstep].widthfreq.freq16 = (uint32_t)(freq * 16 + .5);
+        m_pitches[halfstep].widthfreq.freq = m_pitches[halfstep].widthfreq.freq16 >> 4;
+        m_pitches[halfstep].widthfreq.width = (int32_t)(FREQUENCY / freq + .5);
+    }
+    Buildpitches(0, m_halfsteps - 1);
     StartAdj();
     VCOS[m_vconum] = this;
 }
@@ -100,12 +149,12 @@ Semaphore *VCO::Getvcoadjsem(void)
 
 char *VCO::Getoffsets(void)
 {
-    sprintf(m_buf, "[");
+    int length = sprintf(m_buf, "[");
     for (int tritone = 0; tritone < (m_octaves * 2 + 1); tritone++)
     {
-        sprintf(m_buf, "%s%3d ", m_buf, m_offsets[tritone]);
+        length += sprintf(m_buf + length, "%3d ", m_offsets[tritone]);
     }
-    sprintf(m_buf, "%s]\n\r", m_buf);
+    sprintf(m_buf + length, "]\n\r");
     return (m_buf);
 }
 
@@ -114,7 +163,7 @@ LTC2668 *VCO::Getdac(void)
     return (m_dac);
 }
 
-OctaveXstep VCO::Tritone(int8_t tritone)
+OctaveXstep VCO::Tritone(int8_t tritone) const
 { // returns octave and xstep
     OctaveXstep x;
     int32_t tx = tritone * XSTEPS_PER_TRITONE;
@@ -132,7 +181,7 @@ void VCO::MiniDump(void)
     int8_t o = Getoctave(din);
     int16_t s = Getstep(din);
     OffsetVals ov = m_dac->Getoffsetvals();
-    printf("   VCO %d %04x %5d %6.2f %8.2f %9.4f %2d %4d (%5d %6d %8d %8d %8d %8d %8d)\n\r",
+    printf("   VCO %d %04x %5d %6.2f %8.2f %9.4f %2d %4d (%5d %6d %8d %8d %8d %8d %8d) %6.2f cents %d steps\n\r",
            m_vconum,
            (uint16_t)din & 0xffff,
            (uint16_t)din & 0xffff,
@@ -147,7 +196,9 @@ void VCO::MiniDump(void)
            ov.negadj,
            ov.pos,
            ov.neg,
-           ov.dadj);
+           ov.dadj,
+           (float)ov.error / 256.0,
+           ov.steps);
 }
 
 void VCO::Dump(void)
@@ -193,7 +244,7 @@ void VCO::Dump(void)
     };
 }
 
-int8_t VCO::Gettritone(int16_t octave, int16_t xstep)
+int8_t VCO::Gettritone(int16_t octave, int16_t xstep) const
 {
     return (octave * 2 + xstep / XSTEPS_PER_TRITONE);
 }
@@ -205,9 +256,11 @@ void VCO::Clr(void)
     {
         m_offsets[tritone] = 0;
     };
+    if (m_halfsteps)
+        Buildpitches(0, m_halfsteps - 1);
 }
 
-bool VCO::Gettuned(void)
+bool VCO::Gettuned(void) const
 {
     return (m_tuned);
 }
@@ -217,30 +270,26 @@ FreqChannel *VCO::GetFreqChannel(void)
     return (m_freq_channel);
 }
 
-uint32_t VCO::Getfreq16(int16_t octave, int16_t xstep)
+uint32_t VCO::Getfreq16(int16_t octave, int16_t xstep) const
 { // returns the frequency in Hz * 16
     //printf("G16: %d %d\n\r", octave, xstep);
     //return(pow(2.0, (float)((float)octave*12.0+((float)xstep/(pow(2.0, XPWR))))/12.0)*m_lowfreq);
     // return 2**((octave*12+(xstep/(2**XPWR)))/12.)*m_lowfreq
-    m_omul = m_octavemuls[octave];
-    m_hmul = XSTEPMULS[xstep];
-    m_freq = m_omul * m_hmul;
-    return (m_freq >> (FPWR - 4));
+    uint32_t freq = (uint32_t)(uint16_t)m_octavemuls[octave] * XSTEPMULS[xstep];
+    return (freq >> (FPWR - 4));
 }
 
-uint16_t VCO::Getfreq(int16_t octave, int16_t xstep)
+uint16_t VCO::Getfreq(int16_t octave, int16_t xstep) const
 { // returns the frequency in Hz
-    m_omul = m_octavemuls[octave];
-    m_hmul = XSTEPMULS[xstep];
-    m_freq = m_omul * m_hmul;
-    return (m_freq >> (FPWR));
+    uint32_t freq = (uint32_t)(uint16_t)m_octavemuls[octave] * XSTEPMULS[xstep];
+    return (freq >> (FPWR));
     // throws heap locked:
     // return 2**((octave*12+halfstep)/12.)*m_lowfreq
     // for xstep:
     // return 2**((octave*12+(xstep/(2**XPWR)))/12.)*m_lowfreq
 }
 
-WidthFreq VCO::Getwidth(int16_t octave, int16_t xstep)
+WidthFreq VCO::Getwidth(int16_t octave, int16_t xstep) const
 { // returns wave width
     WidthFreq w;
     w.freq16 = Getfreq16(octave, xstep);
@@ -249,29 +298,34 @@ WidthFreq VCO::Getwidth(int16_t octave, int16_t xstep)
     return w;
 }
 
-int8_t VCO::Getoctave(uint32_t din)
+int8_t VCO::Getoctave(uint32_t din) const
 { // return the octave which corresponds to the DAC's digital input value
     return (din / m_dins_per_volt);
 }
 
-int16_t VCO::Getstep(uint32_t din)
+int16_t VCO::Getstep(uint32_t din) const
 { // return the xstep which corresponds to the DAC's digital input value;
-    m_dinmod = (din % m_dins_per_volt) << XPWR;
-    return (m_dinmod / m_dins_per_halfstep);
+    int32_t dinmod = (din % m_dins_per_volt) << XPWR;
+    return (dinmod / m_dins_per_halfstep);
 }
 
-int16_t VCO::Getoffset(int8_t tritone)
+int16_t VCO::Getoffset(int8_t tritone) const
 { // returns the offset for the tritone
     return (m_offsets[tritone]);
 }
 
-int16_t VCO::Getoffsetsteps(int16_t octave, int16_t xstep)
+int8_t VCO::Gettritones(void) const
 {
-    m_tritone = Gettritone(octave, xstep);
-    m_lo = m_offsets[m_tritone];
-    m_hi = m_offsets[m_tritone + 1];
-    m_trimod = xstep % XSTEPS_PER_TRITONE;
-    return (m_lo + ((m_hi - m_lo) * m_trimod) / XSTEPS_PER_TRITONE);
+    return (m_octaves * 2 + 1);
+}
+
+int16_t VCO::Getoffsetsteps(int16_t octave, int16_t xstep) const
+{
+    int8_t tritone = Gettritone(octave, xstep);
+    int32_t lo = m_offsets[tritone];
+    int32_t hi = m_offsets[tritone + 1];
+    int32_t trimod = xstep % XSTEPS_PER_TRITONE;
+    return (lo + ((hi - lo) * trimod) / XSTEPS_PER_TRITONE);
 }
 
 void VCO::TritoneOffsetsDump(int8_t tritone)
@@ -285,22 +339,22 @@ void VCO::TritoneOffsetsDump(int8_t tritone)
     printf("\n\r");
 }
 
-int16_t VCO::Getdinoffset(uint32_t din)
+int16_t VCO::Getdinoffset(uint32_t din) const
 { // returns the amount of offset for the DAC's digital input value
     return (Getoffsetsteps(Getoctave(din), Getstep(din)));
 }
 
-uint16_t VCO::Dintofreq(uint32_t din)
+uint16_t VCO::Dintofreq(uint32_t din) const
 {
     return (Getfreq(Getoctave(din), Getstep(din)));
 }
 
-uint32_t VCO::Dintofreq16(uint32_t din)
+uint32_t VCO::Dintofreq16(uint32_t din) const
 {
     return (Getfreq16(Getoctave(din), Getstep(din)));
 }
 
-WidthFreq VCO::Dintowidth(uint32_t din)
+WidthFreq VCO::Dintowidth(uint32_t din) const
 { // returns width, tfreq16
     return (Getwidth(Getoctave(din), Getstep(din)));
 }
@@ -308,39 +362,123 @@ WidthFreq VCO::Dintowidth(uint32_t din)
 void VCO::Setoffset(int8_t tritone, int16_t offset)
 { // set the offset for the tritone
     m_offsets[tritone] = offset;
+    Buildpitches((tritone - 1) * HALFSTEPS_PER_TRITONE, (tritone + 1) * HALFSTEPS_PER_TRITONE);
+}
+
+void VCO::Setoffsets(const int16_t *offsets, int8_t tritones)
+{ // the ISRs see either the old or the new offsets, never a mix
+    tritones = tritones > m_octaves * 2 + 1 ? m_octaves * 2 + 1 : tritones;
+    core_util_critical_section_enter();
+    memcpy(m_offsets, offsets, tritones * sizeof(int16_t));
+    Buildpitches(0, m_halfsteps - 1);
+    m_tuned = true;
+    core_util_critical_section_exit();
+}
+
+void VCO::Addoffset(uint32_t din, int16_t dins)
+{ // both tritones around din get the correction so it is all there at din
+    int8_t tritone = Gettritone(Getoctave(din), Getstep(din));
+    int8_t top = m_octaves * 2;
+    tritone = tritone > top ? top : tritone;
+    Setoffset(tritone, m_offsets[tritone] + dins);
+    if (tritone < top)
+        Setoffset(tritone + 1, m_offsets[tritone + 1] + dins);
+}
+
+int32_t VCO::Centstodins(int32_t cents) const
+{ // m_dins_per_volt dins are one octave of 1200 cents
+    return ((int32_t)(((int64_t)cents * m_dins_per_volt) / (1200 << 8)));
+}
+
+void VCO::Buildpitches(int16_t first, int16_t last)
+{ // the offsets of the halfsteps between the neighbouring tritones, Getoffsetsteps at each halfstep
+    int8_t tritone, top = m_octaves * 2;
+    int16_t trimod, offset;
+    first = first < 0 ? 0 : first;
+    last = last >= m_halfsteps ? m_halfsteps - 1 : last;
+    for (int16_t halfstep = first; halfstep <= last; halfstep++)
+    {
+        tritone = halfstep / HALFSTEPS_PER_TRITONE;
+        trimod = halfstep % HALFSTEPS_PER_TRITONE;
+        if (tritone >= top)
+            offset = m_offsets[top];
+        else
+            offset = m_offsets[tritone] + ((m_offsets[tritone + 1] - m_offsets[tritone]) * trimod) / HALFSTEPS_PER_TRITONE;
+        core_util_critical_section_enter(); // Getpitch runs in the envelope ISRs
+        m_pitches[halfstep].offset = offset;
+        core_util_critical_section_exit();
+    }
 }
 
-uint32_t VCO::Dinh(int8_t octave, int8_t halfstep)
+Pitch VCO::Getpitch(uint32_t din) const
+{ // Getdinoffset and Dintowidth from the halfstep table, the divide is a multiply by the reciprocal
+    Pitch p;
+    uint32_t halfstep, rem, frac, bow;
+    const Pitch *lo, *hi;
+    din &= 0xffff;
+    halfstep = (din * m_halfsteprecip) >> PITCHSHIFT; // the rounded up reciprocal is at most one too high
+    rem = din - halfstep * m_dins_per_halfstep;
+    if ((int32_t)rem < 0)
+        halfstep--, rem += m_dins_per_halfstep;
+    if (halfstep >= (uint32_t)(m_halfsteps - 1))
+        halfstep = m_halfsteps - 2, rem = 0;
+    frac = (rem * m_halfsteprecip) >> (PITCHSHIFT - 16); // 0 to 0x10000 between lo and hi
+    lo = &m_pitches[halfstep];
+    hi = lo + 1;
+    // linear between halfsteps less the bow of the exponential, which is .04% in the middle
+    bow = (frac * (0x10000 - frac)) >> 16;
+    p.offset = lo->offset + (int16_t)(((int32_t)(hi->offset - lo->offset) * (int32_t)frac) >> 16);
+    p.widthfreq.width = lo->widthfreq.width + (int32_t)(((int64_t)(hi->widthfreq.width - lo->widthfreq.width) * frac + 0x8000) >> 16);
+    p.widthfreq.width -= (int32_t)(((int64_t)lo->widthfreq.width * bow * PITCHBOW + 0x80000000) >> 32);
+    p.widthfreq.freq16 = lo->widthfreq.freq16 + (uint32_t)((((int64_t)hi->widthfreq.freq16 - (int64_t)lo->widthfreq.freq16) * frac) >> 16);
+    p.widthfreq.freq16 -= (uint32_t)(((uint64_t)lo->widthfreq.freq16 * bow * PITCHBOW) >> 32);
+    p.widthfreq.freq = p.widthfreq.freq16 >> 4;
+    return (p);
+}
+
+uint32_t VCO::Dinh(int8_t octave, int8_t halfstep) const
 { // return DAC's digital input value
     return (octave * m_dins_per_volt + halfstep * m_dins_per_halfstep);
 }
 
-uint32_t VCO::Dinx(int8_t octave, int16_t xstep)
+uint32_t VCO::Dinx(int8_t octave, int16_t xstep) const
 { // return DAC's digital input value
     return ((uint32_t)octave * (uint32_t)m_dins_per_volt + (((uint32_t)xstep * (uint32_t)m_dins_per_halfstep) >> XPWR));
 }
 
-uint32_t VCO::Dinj(int8_t octave, float ratio)
+uint32_t VCO::Dinj(int8_t octave, float ratio) const
 { // return DAC's digital input value ... a ratio of 3/2 is a fifth above the octave in just intonation
-    return (log2((float)pow(2, octave) * ratio) * (float)m_dins_per_volt + .5);
+    return (Xlogtodin((octave * XSTEPS_PER_OCTAVE << XLOGPWR) + Xlog2((uint32_t)(ratio * (1 << 16) + .5f), 16)));
 }
 
-uint32_t VCO::Dinf(uint32_t freq16)
+uint32_t VCO::Dinf(uint32_t freq16) const
 { // return DAC's input value for frequency*16
-    return (log2((float)freq16 / (m_lowfreq * 16.0)) * (float)m_dins_per_volt + .5);
+    return (Xlogtodin(Xlog2(freq16, 0) - m_lowxlog));
+}
+
+uint32_t VCO::Dinw(uint32_t width) const
+{ // FREQUENCY * 16 / width as a log, a 1/16 Hz step is 2 cents at 55 Hz
+    return (Xlogtodin(Xlog2((uint32_t)FREQUENCY << 4, 0) - Xlog2(width, 0) - m_lowxlog));
+}
+
+uint32_t VCO::Xlogtodin(int32_t xlog) const
+{ // 1/256 xsteps above the low frequency to a rounded digital input value, 0 below the low frequency
+    if (xlog <= 0)
+        return (0);
+    return ((uint32_t)(((uint64_t)xlog * m_xlogtodin + (1ULL << 31)) >> 32));
 }
 
-float VCO::Getvolts(uint32_t din)
+float VCO::Getvolts(uint32_t din) const
 { // return the voltage which corresponds to the DAC's digital input value
     return (m_lowvolts + ((float)din / (float)m_dins_per_volt));
 }
 
-OctaveXstep VCO::Freqtooctave(uint32_t freq16)
+OctaveXstep VCO::Freqtooctave(uint32_t freq16) const
 { // return octave and xstep for frequency*16
-    m_din = Dinf(freq16);
+    uint32_t din = Dinf(freq16);
     OctaveXstep x;
-    x.octave = Getoctave(m_din);
-    x.xstep = Getstep(m_din);
+    x.octave = Getoctave(din);
+    x.xstep = Getstep(din);
     return (x);
 }
 
@@ -350,11 +488,12 @@ void VCO::Tuneup(int8_t tritone, float sleep, bool printit)
     int32_t targetdin = Dinx(ox.octave, ox.xstep);
     int32_t offset = 0;
     uint32_t targetfreq16 = Getfreq16(ox.octave, ox.xstep);
-    int16_t cnt = 0, matching = 0, i = 0;
+    int16_t cnt = 0, matching = 0, i = 0, stored = 0, rejected = 0;
     Setoffset(tritone, offset);
-    int16_t *offsets = new int16_t[8];
+    int16_t offsets[AUTOTUNE_TRIES];
     uint32_t freq16 = 0;
     int32_t freqdin;
+    uint8_t confidence;
     bool firsttime = true;
     if (printit)
         printf("tritone %d, targetdin %6d, targetfreq %7.1f, oct %d,%d\n\r",
@@ -371,17 +510,21 @@ void VCO::Tuneup(int8_t tritone, float sleep, bool printit)
         //m_dac->Vout(targetdin+offset, false);     // this sets voltage with offset
         m_dac->Voutprim(targetdin + offset); // this sets voltage with offset
         wait(sleep);                         // allow VCO to settle
-        freq16 = m_freq_channel->SampledFreq16();
+        freq16 = m_freq_channel->SampledFreq16(&confidence);
         if (!freq16)
         {
             printf("Freq16 not OK %d %d %d\n\r", targetdin, offset, freq16);
             break;
         }
         freqdin = (int32_t)Dinf(freq16);
-        if (abs(targetdin - freqdin) > 3000)
-        {
-            printf("   vco %d tdin fdin diff %5d %5d %7.1f %5d %7.1f %5d %d\n\r", m_vconum, abs(targetdin - freqdin), targetdin, (float)targetfreq16 / 16.0, freqdin, (float)freq16 / 16.0, offset, targetdin + offset);
-            continue;
+        if (confidence < FREQ_MINCONFIDENCE || abs(targetdin - freqdin) > 3000)
+        { // still settling or a glitch, as many of them as Autotune tries before the tritone is given up
+            if (confidence >= FREQ_MINCONFIDENCE)
+                printf("   vco %d tdin fdin diff %5d %5d %7.1f %5d %7.1f %5d %d\n\r", m_vconum, abs(targetdin - freqdin), targetdin, (float)targetfreq16 / 16.0, freqdin, (float)freq16 / 16.0, offset, targetdin + offset);
+            if (++rejected < AUTOTUNE_TRIES)
+                continue;
+            printf("Samples not OK %d %d %d\n\r", targetdin, offset, freq16);
+            break;
         }
         offset += (targetdin - freqdin);
         if (printit)
@@ -392,6 +535,7 @@ void VCO::Tuneup(int8_t tritone, float sleep, bool printit)
             continue;
         }
         offsets[cnt] = offset;
+        stored = cnt + 1;
         matching = 0;
         for (i = 0; i < (cnt - 1); i++)
         {
@@ -402,15 +546,16 @@ void VCO::Tuneup(int8_t tritone, float sleep, bool printit)
         }
         if (matching == 3)
             break;
-        if (cnt == 7)
+        if (cnt == AUTOTUNE_TRIES - 1)
             break;
         cnt += 1;
         //if freq == targetfreq: break
     }
     float total = 0.0;
-    for (i = 0; i <= cnt; i++)
+    for (i = 0; i < stored; i++)
         total += (float)offsets[i];
-    offset = round(total / (float)(cnt + 1));
+    if (stored) // else the last offset is kept
+        offset = round(total / (float)stored);
     Setoffset(tritone, offset);
     if (printit)
         printf("%2d %2d %5d %7.1f %s", tritone, cnt, offset, freq16 / 16.0, Getoffsets());
@@ -418,31 +563,67 @@ void VCO::Tuneup(int8_t tritone, float sleep, bool printit)
 
 void VCO::Tuneups(float sleep, bool printit)
 { // tune to the tritone frequency
-    m_dac->Reset();
-    int16_t vout = m_dac->GetVOUT();
     int8_t tritone;
-    Clr(); // clears offset and sets m_tuned false
-    for (tritone = 4; tritone < 19; tritone++)
+    Tunebegin();
+    for (tritone = TUNE_FIRST; tritone <= TUNE_LAST; tritone++)
     {
         Tuneup(tritone, sleep, printit);
     }
+    Tuneend(printit);
+}
+
+void VCO::Tunebegin(void)
+{ // remember the output and clear the offsets before the tritones are tuned
+    m_dac->Reset();
+    m_tunevout = m_dac->GetVOUT();
+    Clr(); // clears offset and sets m_tuned false
+}
+
+void VCO::Tuneend(bool printit)
+{ // extend the tuned offsets to the tritones which are not tuned and restore the output
+    int8_t tritone;
     int16_t offset0, offset1;
-    for (tritone = 16; tritone < 20; tritone++)
+    for (tritone = TUNE_LAST - 2; tritone < TUNE_LAST + 2; tritone++)
     {
         offset0 = Getoffset(tritone);
         offset1 = Getoffset(tritone + 1);
         if (offset1 == 0 and offset0 != 0)
             Setoffset(tritone + 1, offset0);
     }
-    for (tritone = 4; tritone > 0; tritone--)
+    for (tritone = TUNE_FIRST; tritone > 0; tritone--)
     {
         offset0 = Getoffset(tritone);
         offset1 = Getoffset(tritone - 1);
         if (offset1 == 0 and offset0 != 0)
             Setoffset(tritone - 1, offset0);
     }
-    m_dac->Vout(vout, true); // setting adjust True will cause the adjustments to occur.
+    m_dac->Vout(m_tunevout, true); // setting adjust True will cause the adjustments to occur.
     m_tuned = true;
     if (printit)
         printf("%s\n\r%s\n\r", m_freq_channel->vars(), Getoffsets());
 }
+
+void VCO::Setvca(LTC2668 *vca)
+{
+    m_vca = vca;
+}
+
+void VCO::Setgate(bool gate)
+{
+    m_gate = gate;
+}
+
+bool VCO::Idle(void)
+{
+    return (!m_gate && !(m_vca && m_vca->Sounding()));
+}
+
+void VCO::Setretuning(bool retuning)
+{
+    m_retuning = retuning;
+}
+
+bool VCO::Getretuning(void)
+{
+    return (m_retuning);
+}
@@ -6,9 +6,6 @@
 class FreqChannel;
 class LTC2668;
 
-#define _M_LN2 0.693147180559945309417 // Natural log of 2
-#define log2(x) (log(x) / _M_LN2)
-
 #define XPWR 9
 #define HALFSTEPS_PER_OCTAVE 12
 const int32_t XSTEPS_PER_OCTAVE = HALFSTEPS_PER_OCTAVE << XPWR; // 6144
@@ -19,16 +16,11 @@ const int32_t XSTEPS_PER_HALFSTEP = XSTEPS_PER_TRITONE / HALFSTEPS_PER_TRITONE;
 #define OCTAVEPWR 2
 #define FPWR HALFSTEPPWR + OCTAVEPWR
 
-static uint16_t *generate_xsteps()
-{ // static here is "internal linkage"
-    uint16_t *p = new uint16_t[XSTEPS_PER_OCTAVE];
-    for (uint32_t i = 0; i < XSTEPS_PER_OCTAVE; ++i)
-    {
-        p[i] = uint16_t(round(pow((float)2, ((float)i / (float)XSTEPS_PER_OCTAVE)) * pow(2, HALFSTEPPWR)));
-    };
-    return p;
-}
-static uint16_t *XSTEPMULS = generate_xsteps();
+extern const uint16_t XSTEPMULS[XSTEPS_PER_OCTAVE]; // 2**(xstep/XSTEPS_PER_OCTAVE) << HALFSTEPPWR, in xsteps.cpp
+
+#define XLOGPWR 8 // Xlog2 returns 1/256 xsteps
+
+int32_t Xlog2(uint32_t value, int8_t qbits); // log2(value / 2**qbits) in 1/256 xsteps, no floating point
 
 struct OctaveXstep
 {
@@ -42,14 +34,28 @@ struct WidthFreq
     uint32_t freq16;
 };
 
+struct Pitch
+{ // offset correction and target period for a DAC digital input value
+    int16_t offset;
+    WidthFreq widthfreq;
+};
+
+#define PITCHSHIFT 24 // m_halfsteprecip is (1 << PITCHSHIFT) / m_dins_per_halfstep rounded up
+#define PITCHBOW 109  // (ln(2) / 12)**2 / 2 << 16, how far a line between two halfsteps bows from 2**x
+
 class VCO;
 typedef void (*vcoadjtype)(VCO *vco);
 
-#define NUMBERVCOS 6
+#define TUNE_FIRST 4 // tritones tuned by Tuneups and Autotune, the others get the nearest tuned offset
+#define TUNE_LAST 18
+
+#define NUMBERVCOS 8 // tracked voices, VOICEBOARD in board.cpp binds each to a frequency channel and a DAC
+#define NUMBEROCTAVES 11 // most octaves a VCO spans, the size of its tables
 typedef VCO *VCOPtr;
-extern VCOPtr *VCOS;
+extern VCOPtr VCOS[NUMBERVCOS];
 
-class VCO
+class VCO // The const pitch math keeps its intermediate results in locals, so the FuncTimer ISRs, the
+// VCOAdj0 thread and the tuning threads can all call it at the same time without locking.
 {
   private:
     FreqChannel *m_freq_channel;
@@ -57,52 +63,76 @@ class VCO
     vcoadjtype m_vcoadjfunc;
     float m_lowfreq, m_lowvolts;
     bool m_tuned;
-    int8_t m_octaves, m_vconum, m_tritone;
-    int16_t *m_offsets;    // Each tritone has a different offset
-    int16_t *m_octavemuls; // 55, 110, 220 ...
-    uint16_t m_hmul, m_omul;
+    int8_t m_octaves, m_vconum;
+    int16_t m_offsets[NUMBEROCTAVES * 2 + 1]; // Each tritone has a different offset
+    int16_t m_octavemuls[NUMBEROCTAVES + 1];  // 55, 110, 220 ...
     int16_t m_dins_per_volt, m_octaves_per_volt, m_dins_per_halfstep;
-    int32_t m_dinmod, m_xstep, m_hi, m_lo, m_trimod;
-    uint32_t m_freq, m_din;
-    char *m_buf;
+    Pitch m_pitches[NUMBEROCTAVES * HALFSTEPS_PER_OCTAVE + 2]; // one per halfstep, Getpitch interpolates between two of them
+    int16_t m_halfsteps;      // number of m_pitches
+    uint32_t m_halfsteprecip; // replaces the divide by m_dins_per_halfstep
+    int16_t m_tunevout;       // output before tuning, restored by Tuneend
+    int32_t m_lowxlog;        // Xlog2 of m_lowfreq * 16
+    uint32_t m_xlogtodin;     // dins per 1/256 xstep << 32
+    uint32_t Xlogtodin(int32_t xlog) const;
+    LTC2668 *m_vca;           // VCA envelope of the voice, NULL when there is none
+    volatile bool m_gate;     // a note is held
+    volatile bool m_retuning; // Retune has the output, VCOAdj0 leaves it alone
+    char m_buf[(NUMBEROCTAVES * 2 + 1) * 7 + 4]; // Getoffsets, "-32768 " at most for each tritone
     Thread m_thread; //
     Semaphore m_vcoadjsem;
+    void Buildpitches(int16_t first, int16_t last); // rebuild the offsets of a range of halfsteps
 
   public:
+    VCO(void); // for the statically placed voice array, Init before use
     VCO(FreqChannel *freqchannel, LTC2668 *dac, int8_t vconum, float lowfreq, float lowvolts,
         int8_t octaves, int16_t dins_per_volt, int16_t octave_per_volt, vcoadjtype vcoadjfunc);
-    bool Gettuned(void);
+    void Init(FreqChannel *freqchannel, LTC2668 *dac, int8_t vconum, float lowfreq, float lowvolts,
+              int8_t octaves, int16_t dins_per_volt, int16_t octave_per_volt, vcoadjtype vcoadjfunc);
+    bool Gettuned(void) const;
     FreqChannel *GetFreqChannel(void);
     void Info(void);
     void Dump(void);
     void MiniDump(void);
     char *Getoffsets(void);
-    OctaveXstep Tritone(int8_t tritone); // returns octave and xstep
-    int8_t Gettritone(int16_t octave, int16_t xstep);
+    OctaveXstep Tritone(int8_t tritone) const;                   // returns octave and xstep
+    int8_t Gettritone(int16_t octave, int16_t xstep) const;
     void Clr(void);
-    uint32_t Getfreq16(int16_t octave, int16_t xstep);     // returns the frequency in Hz * 16
-    uint16_t Getfreq(int16_t octave, int16_t xstep);       // returns the frequency in Hz
-    WidthFreq Getwidth(int16_t octave, int16_t xstep);     // returns wave width and freq
-    int8_t Getoctave(uint32_t din);                        // return the octave which corresponds to the DAC's digital input value
-    int16_t Getstep(uint32_t din);                         // return the xstep which corresponds to the DAC's digital input value
-    int16_t Getoffset(int8_t tritone);                     // returns the offset for the tritone
-    int16_t Getoffsetsteps(int16_t octave, int16_t xstep); // reuturns offset steps
-    int16_t Getdinoffset(uint32_t din);                    // returns the amount of offset for the DAC's digital input value
-    uint16_t Dintofreq(uint32_t din);
-    uint32_t Dintofreq16(uint32_t din);
-    WidthFreq Dintowidth(uint32_t din);                     // returns width, tfreq16
-    void Setoffset(int8_t tritone, int16_t offset);         // set the offset for the tritone
-    uint32_t Dinh(int8_t octave, int8_t halfstep);          // return DAC's digital input value
-    uint32_t Dinx(int8_t octave, int16_t xstep);            // return DAC's digital input value
-    uint32_t Dinj(int8_t octave, float ratio);              // return DAC's digital input value ... a ratio of 3/2 is a fifth above the octave in just intonation
-    uint32_t Dinf(uint32_t freq16);                         // return DAC's input value for a frequency
-    float Getvolts(uint32_t din);                           // return the voltage which corresponds to the DAC's digital input value
-    OctaveXstep Freqtooctave(uint32_t freq16);              // return octave and xstep for a frequency
-    void Tuneup(int8_t tritone, float sleep, bool printit); // tune to the tritone frequency
-    void Tuneups(float sleep, bool printit);                // tune to the tritone frequency
+    uint32_t Getfreq16(int16_t octave, int16_t xstep) const;     // returns the frequency in Hz * 16
+    uint16_t Getfreq(int16_t octave, int16_t xstep) const;       // returns the frequency in Hz
+    WidthFreq Getwidth(int16_t octave, int16_t xstep) const;     // returns wave width and freq
+    int8_t Getoctave(uint32_t din) const;                        // return the octave which corresponds to the DAC's digital input value
+    int16_t Getstep(uint32_t din) const;                         // return the xstep which corresponds to the DAC's digital input value
+    int16_t Getoffset(int8_t tritone) const;                     // returns the offset for the tritone
+    int8_t Gettritones(void) const;                              // returns the number of tritone offsets
+    int16_t Getoffsetsteps(int16_t octave, int16_t xstep) const; // reuturns offset steps
+    int16_t Getdinoffset(uint32_t din) const;                    // returns the amount of offset for the DAC's digital input value
+    uint16_t Dintofreq(uint32_t din) const;
+    uint32_t Dintofreq16(uint32_t din) const;
+    WidthFreq Dintowidth(uint32_t din) const;                    // returns width, tfreq16
+    Pitch Getpitch(uint32_t din) const;                          // table lookup of Getdinoffset and Dintowidth without divides, for ISRs
+    void Setoffset(int8_t tritone, int16_t offset);              // set the offset for the tritone
+    void Setoffsets(const int16_t *offsets, int8_t tritones);    // replace the offsets in one step
+    void Addoffset(uint32_t din, int16_t dins);                  // add a correction to the tritones around din
+    int32_t Centstodins(int32_t cents) const;                    // 1/256 cents to dins
+    uint32_t Dinh(int8_t octave, int8_t halfstep) const;         // return DAC's digital input value
+    uint32_t Dinx(int8_t octave, int16_t xstep) const;           // return DAC's digital input value
+    uint32_t Dinj(int8_t octave, float ratio) const;             // return DAC's digital input value ... a ratio of 3/2 is a fifth above the octave in just intonation
+    uint32_t Dinf(uint32_t freq16) const;                        // return DAC's input value for a frequency
+    uint32_t Dinw(uint32_t width) const;                         // for a period, without freq16's 1/16 Hz steps
+    float Getvolts(uint32_t din) const;                          // return the voltage which corresponds to the DAC's digital input value
+    OctaveXstep Freqtooctave(uint32_t freq16) const;             // return octave and xstep for a frequency
+    void Tuneup(int8_t tritone, float sleep, bool printit);      // tune to the tritone frequency
+    void Tuneups(float sleep, bool printit);                     // tune to the tritone frequency
+    void Tunebegin(void);                                        // clear the offsets before tuning
+    void Tuneend(bool printit);                                  // fill in the untuned tritones and restore the output
     void TritoneOffsetsDump(int8_t tritone);
     Semaphore *Getvcoadjsem(void);
     LTC2668 *Getdac(void);
+    void Setvca(LTC2668 *vca);
+    void Setgate(bool gate); // NoteOn and NoteOff
+    bool Idle(void);         // no MIDI note is held and the VCA envelope has finished, menu pitches are not seen
+    void Setretuning(bool retuning);
+    bool Getretuning(void);
     void StartAdj(void);
     void StopAdj(void);
 };
@@ -21,6 +21,41 @@ const uint16_t Waves::vcf[] = {
     /* 5 */ 0x4000, 0x4400, 0x4800, 0x4c00, 0x5000, 0x5400, 0x5800, 0x5c00, 0x6000, 0x6800, 0x7000, 0x7800, 0x7000, 0x6800, 0x6000, 0x5800, 0x5000, 0x4800, 0x4000, 0x0000, 0x6000, 0x5800, 0x5000, 0x4800, 0x4000, 0x3c00, 0x3800, 0x3400, 0x3000, 1,
     /* 6 */ 0x4000, 0x4400, 0x4800, 0x4c00, 0x5000, 0x5400, 0x5800, 0x5c00, 0x6000, 0x6400, 0x6800, 0x7000, 0x7800, 0x7400, 0x7000, 0x6800, 0x6000, 0x5800, 0x5000, 0x4800, 0x4000, 0x0000, 0x6000, 0x5c00, 0x5800, 0x5400, 0x5000, 0x4800, 0x4000, 0x3c00, 0x3800, 0x3400, 0x3000, 1,
     /* 7 */ 0x4000, 0x4400, 0x4800, 0x4c00, 0x5000, 0x5400, 0x5800, 0x5c00, 0x6000, 0x6400, 0x6800, 0x6c00, 0x7000, 0x7400, 0x7800, 0x7400, 0x7000, 0x6800, 0x6400, 0x6000, 0x5800, 0x5000, 0x4800, 0x4000, 0x0000, 0x6000, 0x5c00, 0x5800, 0x5400, 0x5000, 0x4c00, 0x4800, 0x4400, 0x4000, 0x3c00, 0x3800, 0x3400, 0x3000, 1};
+WaveBank vcabank(Waves::vca, NUMBERWAVES);
+WaveBank vcfbank(Waves::vcf, NUMBERWAVES);
+
+WaveBank::WaveBank(const uint16_t *waves, int8_t count)
+{
+    int16_t offset;
+    m_count = count > NUMBERWAVES ? NUMBERWAVES : count;
+    for (int8_t wavenum = 0; wavenum < m_count; wavenum++)
+    {
+        m_waves[wavenum].points = waves;
+        m_waves[wavenum].hold = -1;
+        for (offset = 0; waves[offset] != 1; offset++)
+        {
+            if (!waves[offset])
+                m_waves[wavenum].hold = offset;
+        }
+        m_waves[wavenum].end = offset;
+        if (m_waves[wavenum].hold < 0)
+            m_waves[wavenum].hold = offset; // no hold, release goes to the end
+        waves += offset + 1;
+    }
+}
+
+const Wave *WaveBank::Get(int8_t wavenum)
+{
+    if (wavenum < 0 || wavenum >= m_count)
+        wavenum = 0;
+    return (&m_waves[wavenum]);
+}
+
+int8_t WaveBank::Count(void)
+{
+    return (m_count);
+}
+
 /*
 const uint16_t vcawaves[128] = {
       0xffff, 0xa000, 0, 0x9000, 0x7000, 0x5000, 0x3000, 1,
@@ -10,4 +10,29 @@ class Waves
 };
 //extern const uint16_t vcawaves[];
 
+#define NUMBERWAVES 8 // waves in each of the Waves tables
+
+struct Wave
+{
+    const uint16_t *points; // first point, 0 marks the hold and 1 marks the end
+    int16_t hold;           // offset of the hold marker, the release begins at hold + 1
+    int16_t end;            // offset of the end marker
+};
+
+class WaveBank // Index of the waves in one Waves table.  The table is scanned once when the bank is
+// constructed so choosing a wave on note-on is a lookup, and LTC2668::Setwave only swaps a pointer.
+{
+  private:
+    Wave m_waves[NUMBERWAVES];
+    int8_t m_count;
+
+  public:
+    WaveBank(const uint16_t *waves, int8_t count);
+    const Wave *Get(int8_t wavenum);
+    int8_t Count(void);
+};
+
+extern WaveBank vcabank;
+extern WaveBank vcfbank;
+
 #endif
\ No newline at end of file
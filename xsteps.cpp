@@ -0,0 +1,520 @@
+// xsteps.cpp ... XSTEPMULS, the multipliers for the xsteps of one octave, kept in flash
+// Generated once with the same single precision math the table used to be built with at startup:
+//     XSTEPMULS[i] = roundf(powf(2, (float)i / XSTEPS_PER_OCTAVE) * (1 << HALFSTEPPWR))
+#include "mbed.h"
+#include "vco.h"
+
+const uint16_t XSTEPMULS[XSTEPS_PER_OCTAVE] = {
+    32768, 32772, 32775, 32779, 32783, 32786, 32790, 32794, 32798, 32801, 32805, 32809,
+    32812, 32816, 32820, 32824, 32827, 32831, 32835, 32838, 32842, 32846, 32849, 32853,
+    32857, 32861, 32864, 32868, 32872, 32875, 32879, 32883, 32887, 32890, 32894, 32898,
+    32901, 32905, 32909, 32912, 32916, 32920, 32924, 32927, 32931, 32935, 32938, 32942,
+    32946, 32950, 32953, 32957, 32961, 32965, 32968, 32972, 32976, 32979, 32983, 32987,
+    32991, 32994, 32998, 33002, 33005, 33009, 33013, 33017, 33020, 33024, 33028, 33032,
+    33035, 33039, 33043, 33046, 33050, 33054, 33058, 33061, 33065, 33069, 33073, 33076,
+    33080, 33084, 33087, 33091, 33095, 33099, 33102, 33106, 33110, 33114, 33117, 33121,
+    33125, 33129, 33132, 33136, 33140, 33144, 33147, 33151, 33155, 33158, 33162, 33166,
+    33170, 33173, 33177, 33181, 33185, 33188, 33192, 33196, 33200, 33203, 33207, 33211,
+    33215, 33218, 33222, 33226, 33230, 33233, 33237, 33241, 33245, 33248, 33252, 33256,
+    33260, 33263, 33267, 33271, 33275, 33278, 33282, 33286, 33290, 33293, 33297, 33301,
+    33305, 33308, 33312, 33316, 33320, 33323, 33327, 33331, 33335, 33339, 33342, 33346,
+    33350, 33354, 33357, 33361, 33365, 33369, 33372, 33376, 33380, 33384, 33387, 33391,
+    33395, 33399, 33403, 33406, 33410, 33414, 33418, 33421, 33425, 33429, 33433, 33436,
+    33440, 33444, 33448, 33452, 33455, 33459, 33463, 33467, 33470, 33474, 33478, 33482,
+    33486, 33489, 33493, 33497, 33501, 33504, 33508, 33512, 33516, 33520, 33523, 33527,
+    33531, 33535, 33538, 33542, 33546, 33550, 33554, 33557, 33561, 33565, 33569, 33573,
+    33576, 33580, 33584, 33588, 33591, 33595, 33599, 33603, 33607, 33610, 33614, 33618,
+    33622, 33626, 33629, 33633, 33637, 33641, 33645, 33648, 33652, 33656, 33660, 33664,
+    33667, 33671, 33675, 33679, 33683, 33686, 33690, 33694, 33698, 33702, 33705, 33709,
+    33713, 33717, 33721, 33724, 33728, 33732, 33736, 33740, 33743, 33747, 33751, 33755,
+    33759, 33762, 33766, 33770, 33774, 33778, 33781, 33785, 33789, 33793, 33797, 33801,
+    33804, 33808, 33812, 33816, 33820, 33823, 33827, 33831, 33835, 33839, 33843, 33846,
+    33850, 33854, 33858, 33862, 33865, 33869, 33873, 33877, 33881, 33885, 33888, 33892,
+    33896, 33900, 33904, 33907, 33911, 33915, 33919, 33923, 33927, 33930, 33934, 33938,
+    33942, 33946, 33950, 33953, 33957, 33961, 33965, 33969, 33973, 33976, 33980, 33984,
+    33988, 33992, 33996, 33999, 34003, 34007, 34011, 34015, 34019, 34022, 34026, 34030,
+    34034, 34038, 34042, 34045, 34049, 34053, 34057, 34061, 34065, 34069, 34072, 34076,
+    34080, 34084, 34088, 34092, 34095, 34099, 34103, 34107, 34111, 34115, 34119, 34122,
+    34126, 34130, 34134, 34138, 34142, 34145, 34149, 34153, 34157, 34161, 34165, 34169,
+    34172, 34176, 34180, 34184, 34188, 34192, 34196, 34199, 34203, 34207, 34211, 34215,
+    34219, 34223, 34226, 34230, 34234, 34238, 34242, 34246, 34250, 34254, 34257, 34261,
+    34265, 34269, 34273, 34277, 34281, 34284, 34288, 34292, 34296, 34300, 34304, 34308,
+    34312, 34315, 34319, 34323, 34327, 34331, 34335, 34339, 34343, 34346, 34350, 34354,
+    34358, 34362, 34366, 34370, 34374, 34377, 34381, 34385, 34389, 34393, 34397, 34401,
+    34405, 34408, 34412, 34416, 34420, 34424, 34428, 34432, 34436, 34440, 34443, 34447,
+    34451, 34455, 34459, 34463, 34467, 34471, 34475, 34478, 34482, 34486, 34490, 34494,
+    34498, 34502, 34506, 34510, 34513, 34517, 34521, 34525, 34529, 34533, 34537, 34541,
+    34545, 34548, 34552, 34556, 34560, 34564, 34568, 34572, 34576, 34580, 34584, 34587,
+    34591, 34595, 34599, 34603, 34607, 34611, 34615, 34619, 34623, 34627, 34630, 34634,
+    34638, 34642, 34646, 34650, 34654, 34658, 34662, 34666, 34670, 34673, 34677, 34681,
+    34685, 34689, 34693, 34697, 34701, 34705, 34709, 34713, 34716, 34720, 34724, 34728,
+    34732, 34736, 34740, 34744, 34748, 34752, 34756, 34760, 34764, 34767, 34771, 34775,
+    34779, 34783, 34787, 34791, 34795, 34799, 34803, 34807, 34811, 34815, 34818, 34822,
+    34826, 34830, 34834, 34838, 34842, 34846, 34850, 34854, 34858, 34862, 34866, 34870,
+    34874, 34877, 34881, 34885, 34889, 34893, 34897, 34901, 34905, 34909, 34913, 34917,
+    34921, 34925, 34929, 34933, 34937, 34940, 34944, 34948, 34952, 34956, 34960, 34964,
+    34968, 34972, 34976, 34980, 34984, 34988, 34992, 34996, 35000, 35004, 35008, 35011,
+    35015, 35019, 35023, 35027, 35031, 35035, 35039, 35043, 35047, 35051, 35055, 35059,
+    35063, 35067, 35071, 35075, 35079, 35083, 35087, 35091, 35095, 35098, 35102, 35106,
+    35110, 35114, 35118, 35122, 35126, 35130, 35134, 35138, 35142, 35146, 35150, 35154,
+    35158, 35162, 35166, 35170, 35174, 35178, 35182, 35186, 35190, 35194, 35198, 35202,
+    35206, 35210, 35214, 35217, 35221, 35225, 35229, 35233, 35237, 35241, 35245, 35249,
+    35253, 35257, 35261, 35265, 35269, 35273, 35277, 35281, 35285, 35289, 35293, 35297,
+    35301, 35305, 35309, 35313, 35317, 35321, 35325, 35329, 35333, 35337, 35341, 35345,
+    35349, 35353, 35357, 35361, 35365, 35369, 35373, 35377, 35381, 35385, 35389, 35393,
+    35397, 35401, 35405, 35409, 35413, 35417, 35421, 35425, 35429, 35433, 35437, 35441,
+    35445, 35449, 35453, 35457, 35461, 35465, 35469, 35473, 35477, 35481, 35485, 35489,
+    35493, 35497, 35501, 35505, 35509, 35513, 35517, 35521, 35525, 35529, 35533, 35537,
+    35541, 35545, 35549, 35553, 35557, 35561, 35565, 35569, 35573, 35577, 35581, 35585,
+    35589, 35593, 35597, 35601, 35605, 35609, 35613, 35617, 35621, 35625, 35629, 35633,
+    35637, 35641, 35645, 35649, 35653, 35657, 35661, 35665, 35669, 35673, 35677, 35681,
+    35685, 35689, 35693, 35697, 35702, 35706, 35710, 35714, 35718, 35722, 35726, 35730,
+    35734, 35738, 35742, 35746, 35750, 35754, 35758, 35762, 35766, 35770, 35774, 35778,
+    35782, 35786, 35790, 35794, 35798, 35802, 35806, 35810, 35814, 35819, 35823, 35827,
+    35831, 35835, 35839, 35843, 35847, 35851, 35855, 35859, 35863, 35867, 35871, 35875,
+    35879, 35883, 35887, 35891, 35895, 35899, 35903, 35908, 35912, 35916, 35920, 35924,
+    35928, 35932, 35936, 35940, 35944, 35948, 35952, 35956, 35960, 35964, 35968, 35972,
+    35976, 35981, 35985, 35989, 35993, 35997, 36001, 36005, 36009, 36013, 36017, 36021,
+    36025, 36029, 36033, 36037, 36041, 36046, 36050, 36054, 36058, 36062, 36066, 36070,
+    36074, 36078, 36082, 36086, 36090, 36094, 36098, 36103, 36107, 36111, 36115, 36119,
+    36123, 36127, 36131, 36135, 36139, 36143, 36147, 36151, 36155, 36160, 36164, 36168,
+    36172, 36176, 36180, 36184, 36188, 36192, 36196, 36200, 36204, 36209, 36213, 36217,
+    36221, 36225, 36229, 36233, 36237, 36241, 36245, 36249, 36254, 36258, 36262, 36266,
+    36270, 36274, 36278, 36282, 36286, 36290, 36294, 36299, 36303, 36307, 36311, 36315,
+    36319, 36323, 36327, 36331, 36335, 36340, 36344, 36348, 36352, 36356, 36360, 36364,
+    36368, 36372, 36376, 36381, 36385, 36389, 36393, 36397, 36401, 36405, 36409, 36413,
+    36417, 36422, 36426, 36430, 36434, 36438, 36442, 36446, 36450, 36454, 36459, 36463,
+    36467, 36471, 36475, 36479, 36483, 36487, 36492, 36496, 36500, 36504, 36508, 36512,
+    36516, 36520, 36524, 36529, 36533, 36537, 36541, 36545, 36549, 36553, 36557, 36562,
+    36566, 36570, 36574, 36578, 36582, 36586, 36590, 36595, 36599, 36603, 36607, 36611,
+    36615, 36619, 36623, 36628, 36632, 36636, 36640, 36644, 36648, 36652, 36657, 36661,
+    36665, 36669, 36673, 36677, 36681, 36686, 36690, 36694, 36698, 36702, 36706, 36710,
+    36715, 36719, 36723, 36727, 36731, 36735, 36739, 36744, 36748, 36752, 36756, 36760,
+    36764, 36768, 36773, 36777, 36781, 36785, 36789, 36793, 36797, 36802, 36806, 36810,
+    36814, 36818, 36822, 36827, 36831, 36835, 36839, 36843, 36847, 36851, 36856, 36860,
+    36864, 36868, 36872, 36876, 36881, 36885, 36889, 36893, 36897, 36901, 36906, 36910,
+    36914, 36918, 36922, 36926, 36931, 36935, 36939, 36943, 36947, 36951, 36956, 36960,
+    36964, 36968, 36972, 36976, 36981, 36985, 36989, 36993, 36997, 37001, 37006, 37010,
+    37014, 37018, 37022, 37026, 37031, 37035, 37039, 37043, 37047, 37052, 37056, 37060,
+    37064, 37068, 37072, 37077, 37081, 37085, 37089, 37093, 37098, 37102, 37106, 37110,
+    37114, 37118, 37123, 37127, 37131, 37135, 37139, 37144, 37148, 37152, 37156, 37160,
+    37165, 37169, 37173, 37177, 37181, 37186, 37190, 37194, 37198, 37202, 37207, 37211,
+    37215, 37219, 37223, 37228, 37232, 37236, 37240, 37244, 37249, 37253, 37257, 37261,
+    37265, 37270, 37274, 37278, 37282, 37286, 37291, 37295, 37299, 37303, 37307, 37312,
+    37316, 37320, 37324, 37328, 37333, 37337, 37341, 37345, 37350, 37354, 37358, 37362,
+    37366, 37371, 37375, 37379, 37383, 37387, 37392, 37396, 37400, 37404, 37409, 37413,
+    37417, 37421, 37425, 37430, 37434, 37438, 37442, 37447, 37451, 37455, 37459, 37463,
+    37468, 37472, 37476, 37480, 37485, 37489, 37493, 37497, 37502, 37506, 37510, 37514,
+    37518, 37523, 37527, 37531, 37535, 37540, 37544, 37548, 37552, 37557, 37561, 37565,
+    37569, 37574, 37578, 37582, 37586, 37590, 37595, 37599, 37603, 37607, 37612, 37616,
+    37620, 37624, 37629, 37633, 37637, 37641, 37646, 37650, 37654, 37658, 37663, 37667,
+    37671, 37675, 37680, 37684, 37688, 37692, 37697, 37701, 37705, 37709, 37714, 37718,
+    37722, 37726, 37731, 37735, 37739, 37743, 37748, 37752, 37756, 37760, 37765, 37769,
+    37773, 37778, 37782, 37786, 37790, 37795, 37799, 37803, 37807, 37812, 37816, 37820,
+    37824, 37829, 37833, 37837, 37842, 37846, 37850, 37854, 37859, 37863, 37867, 37871,
+    37876, 37880, 37884, 37889, 37893, 37897, 37901, 37906, 37910, 37914, 37918, 37923,
+    37927, 37931, 37936, 37940, 37944, 37948, 37953, 37957, 37961, 37966, 37970, 37974,
+    37978, 37983, 37987, 37991, 37996, 38000, 38004, 38008, 38013, 38017, 38021, 38026,
+    38030, 38034, 38038, 38043, 38047, 38051, 38056, 38060, 38064, 38068, 38073, 38077,
+    38081, 38086, 38090, 38094, 38099, 38103, 38107, 38111, 38116, 38120, 38124, 38129,
+    38133, 38137, 38142, 38146, 38150, 38154, 38159, 38163, 38167, 38172, 38176, 38180,
+    38185, 38189, 38193, 38198, 38202, 38206, 38210, 38215, 38219, 38223, 38228, 38232,
+    38236, 38241, 38245, 38249, 38254, 38258, 38262, 38267, 38271, 38275, 38279, 38284,
+    38288, 38292, 38297, 38301, 38305, 38310, 38314, 38318, 38323, 38327, 38331, 38336,
+    38340, 38344, 38349, 38353, 38357, 38362, 38366, 38370, 38375, 38379, 38383, 38388,
+    38392, 38396, 38401, 38405, 38409, 38414, 38418, 38422, 38427, 38431, 38435, 38440,
+    38444, 38448, 38453, 38457, 38461, 38466, 38470, 38474, 38479, 38483, 38487, 38492,
+    38496, 38500, 38505, 38509, 38513, 38518, 38522, 38526, 38531, 38535, 38539, 38544,
+    38548, 38553, 38557, 38561, 38566, 38570, 38574, 38579, 38583, 38587, 38592, 38596,
+    38600, 38605, 38609, 38613, 38618, 38622, 38627, 38631, 38635, 38640, 38644, 38648,
+    38653, 38657, 38661, 38666, 38670, 38675, 38679, 38683, 38688, 38692, 38696, 38701,
+    38705, 38709, 38714, 38718, 38723, 38727, 38731, 38736, 38740, 38744, 38749, 38753,
+    38757, 38762, 38766, 38771, 38775, 38779, 38784, 38788, 38792, 38797, 38801, 38806,
+    38810, 38814, 38819, 38823, 38828, 38832, 38836, 38841, 38845, 38849, 38854, 38858,
+    38863, 38867, 38871, 38876, 38880, 38885, 38889, 38893, 38898, 38902, 38906, 38911,
+    38915, 38920, 38924, 38928, 38933, 38937, 38942, 38946, 38950, 38955, 38959, 38964,
+    38968, 38972, 38977, 38981, 38986, 38990, 38994, 38999, 39003, 39008, 39012, 39016,
+    39021, 39025, 39030, 39034, 39038, 39043, 39047, 39052, 39056, 39060, 39065, 39069,
+    39074, 39078, 39082, 39087, 39091, 39096, 39100, 39104, 39109, 39113, 39118, 39122,
+    39127, 39131, 39135, 39140, 39144, 39149, 39153, 39157, 39162, 39166, 39171, 39175,
+    39180, 39184, 39188, 39193, 39197, 39202, 39206, 39210, 39215, 39219, 39224, 39228,
+    39233, 39237, 39241, 39246, 39250, 39255, 39259, 39264, 39268, 39272, 39277, 39281,
+    39286, 39290, 39295, 39299, 39303, 39308, 39312, 39317, 39321, 39326, 39330, 39335,
+    39339, 39343, 39348, 39352, 39357, 39361, 39366, 39370, 39375, 39379, 39383, 39388,
+    39392, 39397, 39401, 39406, 39410, 39415, 39419, 39423, 39428, 39432, 39437, 39441,
+    39446, 39450, 39455, 39459, 39463, 39468, 39472, 39477, 39481, 39486, 39490, 39495,
+    39499, 39504, 39508, 39512, 39517, 39521, 39526, 39530, 39535, 39539, 39544, 39548,
+    39553, 39557, 39562, 39566, 39570, 39575, 39579, 39584, 39588, 39593, 39597, 39602,
+    39606, 39611, 39615, 39620, 39624, 39629, 39633, 39637, 39642, 39646, 39651, 39655,
+    39660, 39664, 39669, 39673, 39678, 39682, 39687, 39691, 39696, 39700, 39705, 39709,
+    39714, 39718, 39723, 39727, 39731, 39736, 39740, 39745, 39749, 39754, 39758, 39763,
+    39767, 39772, 39776, 39781, 39785, 39790, 39794, 39799, 39803, 39808, 39812, 39817,
+    39821, 39826, 39830, 39835, 39839, 39844, 39848, 39853, 39857, 39862, 39866, 39871,
+    39875, 39880, 39884, 39889, 39893, 39898, 39902, 39907, 39911, 39916, 39920, 39925,
+    39929, 39934, 39938, 39943, 39947, 39952, 39956, 39961, 39965, 39970, 39974, 39979,
+    39983, 39988, 39992, 39997, 40001, 40006, 40010, 40015, 40019, 40024, 40028, 40033,
+    40037, 40042, 40046, 40051, 40056, 40060, 40065, 40069, 40074, 40078, 40083, 40087,
+    40092, 40096, 40101, 40105, 40110, 40114, 40119, 40123, 40128, 40132, 40137, 40141,
+    40146, 40151, 40155, 40160, 40164, 40169, 40173, 40178, 40182, 40187, 40191, 40196,
+    40200, 40205, 40209, 40214, 40219, 40223, 40228, 40232, 40237, 40241, 40246, 40250,
+    40255, 40259, 40264, 40268, 40273, 40278, 40282, 40287, 40291, 40296, 40300, 40305,
+    40309, 40314, 40318, 40323, 40328, 40332, 40337, 40341, 40346, 40350, 40355, 40359,
+    40364, 40369, 40373, 40378, 40382, 40387, 40391, 40396, 40400, 40405, 40410, 40414,
+    40419, 40423, 40428, 40432, 40437, 40441, 40446, 40451, 40455, 40460, 40464, 40469,
+    40473, 40478, 40483, 40487, 40492, 40496, 40501, 40505, 40510, 40515, 40519, 40524,
+    40528, 40533, 40537, 40542, 40547, 40551, 40556, 40560, 40565, 40569, 40574, 40579,
+    40583, 40588, 40592, 40597, 40601, 40606, 40611, 40615, 40620, 40624, 40629, 40634,
+    40638, 40643, 40647, 40652, 40656, 40661, 40666, 40670, 40675, 40679, 40684, 40689,
+    40693, 40698, 40702, 40707, 40712, 40716, 40721, 40725, 40730, 40735, 40739, 40744,
+    40748, 40753, 40758, 40762, 40767, 40771, 40776, 40781, 40785, 40790, 40794, 40799,
+    40804, 40808, 40813, 40817, 40822, 40827, 40831, 40836, 40840, 40845, 40850, 40854,
+    40859, 40863, 40868, 40873, 40877, 40882, 40886, 40891, 40896, 40900, 40905, 40910,
+    40914, 40919, 40923, 40928, 40933, 40937, 40942, 40946, 40951, 40956, 40960, 40965,
+    40970, 40974, 40979, 40983, 40988, 40993, 40997, 41002, 41007, 41011, 41016, 41020,
+    41025, 41030, 41034, 41039, 41044, 41048, 41053, 41057, 41062, 41067, 41071, 41076,
+    41081, 41085, 41090, 41095, 41099, 41104, 41108, 41113, 41118, 41122, 41127, 41132,
+    41136, 41141, 41146, 41150, 41155, 41160, 41164, 41169, 41173, 41178, 41183, 41187,
+    41192, 41197, 41201, 41206, 41211, 41215, 41220, 41225, 41229, 41234, 41239, 41243,
+    41248, 41253, 41257, 41262, 41266, 41271, 41276, 41280, 41285, 41290, 41294, 41299,
+    41304, 41308, 41313, 41318, 41322, 41327, 41332, 41336, 41341, 41346, 41350, 41355,
+    41360, 41364, 41369, 41374, 41378, 41383, 41388, 41392, 41397, 41402, 41406, 41411,
+    41416, 41420, 41425, 41430, 41434, 41439, 41444, 41448, 41453, 41458, 41462, 41467,
+    41472, 41477, 41481, 41486, 41491, 41495, 41500, 41505, 41509, 41514, 41519, 41523,
+    41528, 41533, 41537, 41542, 41547, 41551, 41556, 41561, 41566, 41570, 41575, 41580,
+    41584, 41589, 41594, 41598, 41603, 41608, 41612, 41617, 41622, 41627, 41631, 41636,
+    41641, 41645, 41650, 41655, 41659, 41664, 41669, 41673, 41678, 41683, 41688, 41692,
+    41697, 41702, 41706, 41711, 41716, 41721, 41725, 41730, 41735, 41739, 41744, 41749,
+    41753, 41758, 41763, 41768, 41772, 41777, 41782, 41786, 41791, 41796, 41801, 41805,
+    41810, 41815, 41819, 41824, 41829, 41834, 41838, 41843, 41848, 41853, 41857, 41862,
+    41867, 41871, 41876, 41881, 41886, 41890, 41895, 41900, 41905, 41909, 41914, 41919,
+    41923, 41928, 41933, 41938, 41942, 41947, 41952, 41957, 41961, 41966, 41971, 41975,
+    41980, 41985, 41990, 41994, 41999, 42004, 42009, 42013, 42018, 42023, 42028, 42032,
+    42037, 42042, 42047, 42051, 42056, 42061, 42066, 42070, 42075, 42080, 42085, 42089,
+    42094, 42099, 42104, 42108, 42113, 42118, 42123, 42127, 42132, 42137, 42142, 42146,
+    42151, 42156, 42161, 42165, 42170, 42175, 42180, 42184, 42189, 42194, 42199, 42203,
+    42208, 42213, 42218, 42222, 42227, 42232, 42237, 42242, 42246, 42251, 42256, 42261,
+    42265, 42270, 42275, 42280, 42284, 42289, 42294, 42299, 42304, 42308, 42313, 42318,
+    42323, 42327, 42332, 42337, 42342, 42346, 42351, 42356, 42361, 42366, 42370, 42375,
+    42380, 42385, 42390, 42394, 42399, 42404, 42409, 42413, 42418, 42423, 42428, 42433,
+    42437, 42442, 42447, 42452, 42457, 42461, 42466, 42471, 42476, 42480, 42485, 42490,
+    42495, 42500, 42504, 42509, 42514, 42519, 42524, 42528, 42533, 42538, 42543, 42548,
+    42552, 42557, 42562, 42567, 42572, 42576, 42581, 42586, 42591, 42596, 42600, 42605,
+    42610, 42615, 42620, 42624, 42629, 42634, 42639, 42644, 42649, 42653, 42658, 42663,
+    42668, 42673, 42677, 42682, 42687, 42692, 42697, 42701, 42706, 42711, 42716, 42721,
+    42726, 42730, 42735, 42740, 42745, 42750, 42755, 42759, 42764, 42769, 42774, 42779,
+    42783, 42788, 42793, 42798, 42803, 42808, 42812, 42817, 42822, 42827, 42832, 42837,
+    42841, 42846, 42851, 42856, 42861, 42866, 42870, 42875, 42880, 42885, 42890, 42895,
+    42899, 42904, 42909, 42914, 42919, 42924, 42929, 42933, 42938, 42943, 42948, 42953,
+    42958, 42962, 42967, 42972, 42977, 42982, 42987, 42992, 42996, 43001, 43006, 43011,
+    43016, 43021, 43025, 43030, 43035, 43040, 43045, 43050, 43055, 43059, 43064, 43069,
+    43074, 43079, 43084, 43089, 43093, 43098, 43103, 43108, 43113, 43118, 43123, 43128,
+    43132, 43137, 43142, 43147, 43152, 43157, 43162, 43166, 43171, 43176, 43181, 43186,
+    43191, 43196, 43201, 43205, 43210, 43215, 43220, 43225, 43230, 43235, 43240, 43244,
+    43249, 43254, 43259, 43264, 43269, 43274, 43279, 43284, 43288, 43293, 43298, 43303,
+    43308, 43313, 43318, 43323, 43327, 43332, 43337, 43342, 43347, 43352, 43357, 43362,
+    43367, 43371, 43376, 43381, 43386, 43391, 43396, 43401, 43406, 43411, 43416, 43420,
+    43425, 43430, 43435, 43440, 43445, 43450, 43455, 43460, 43465, 43469, 43474, 43479,
+    43484, 43489, 43494, 43499, 43504, 43509, 43514, 43519, 43523, 43528, 43533, 43538,
+    43543, 43548, 43553, 43558, 43563, 43568, 43573, 43577, 43582, 43587, 43592, 43597,
+    43602, 43607, 43612, 43617, 43622, 43627, 43632, 43637, 43641, 43646, 43651, 43656,
+    43661, 43666, 43671, 43676, 43681, 43686, 43691, 43696, 43701, 43706, 43710, 43715,
+    43720, 43725, 43730, 43735, 43740, 43745, 43750, 43755, 43760, 43765, 43770, 43775,
+    43780, 43784, 43789, 43794, 43799, 43804, 43809, 43814, 43819, 43824, 43829, 43834,
+    43839, 43844, 43849, 43854, 43859, 43864, 43869, 43873, 43878, 43883, 43888, 43893,
+    43898, 43903, 43908, 43913, 43918, 43923, 43928, 43933, 43938, 43943, 43948, 43953,
+    43958, 43963, 43968, 43973, 43978, 43983, 43987, 43992, 43997, 44002, 44007, 44012,
+    44017, 44022, 44027, 44032, 44037, 44042, 44047, 44052, 44057, 44062, 44067, 44072,
+    44077, 44082, 44087, 44092, 44097, 44102, 44107, 44112, 44117, 44122, 44127, 44132,
+    44137, 44142, 44147, 44152, 44157, 44161, 44166, 44171, 44176, 44181, 44186, 44191,
+    44196, 44201, 44206, 44211, 44216, 44221, 44226, 44231, 44236, 44241, 44246, 44251,
+    44256, 44261, 44266, 44271, 44276, 44281, 44286, 44291, 44296, 44301, 44306, 44311,
+    44316, 44321, 44326, 44331, 44336, 44341, 44346, 44351, 44356, 44361, 44366, 44371,
+    44376, 44381, 44386, 44391, 44396, 44401, 44406, 44411, 44416, 44421, 44426, 44431,
+    44436, 44441, 44446, 44451, 44456, 44461, 44466, 44471, 44476, 44482, 44487, 44492,
+    44497, 44502, 44507, 44512, 44517, 44522, 44527, 44532, 44537, 44542, 44547, 44552,
+    44557, 44562, 44567, 44572, 44577, 44582, 44587, 44592, 44597, 44602, 44607, 44612,
+    44617, 44622, 44627, 44632, 44637, 44642, 44647, 44652, 44657, 44663, 44668, 44673,
+    44678, 44683, 44688, 44693, 44698, 44703, 44708, 44713, 44718, 44723, 44728, 44733,
+    44738, 44743, 44748, 44753, 44758, 44763, 44768, 44774, 44779, 44784, 44789, 44794,
+    44799, 44804, 44809, 44814, 44819, 44824, 44829, 44834, 44839, 44844, 44849, 44854,
+    44859, 44865, 44870, 44875, 44880, 44885, 44890, 44895, 44900, 44905, 44910, 44915,
+    44920, 44925, 44930, 44935, 44941, 44946, 44951, 44956, 44961, 44966, 44971, 44976,
+    44981, 44986, 44991, 44996, 45001, 45006, 45012, 45017, 45022, 45027, 45032, 45037,
+    45042, 45047, 45052, 45057, 45062, 45067, 45073, 45078, 45083, 45088, 45093, 45098,
+    45103, 45108, 45113, 45118, 45123, 45129, 45134, 45139, 45144, 45149, 45154, 45159,
+    45164, 45169, 45174, 45179, 45185, 45190, 45195, 45200, 45205, 45210, 45215, 45220,
+    45225, 45230, 45236, 45241, 45246, 45251, 45256, 45261, 45266, 45271, 45276, 45282,
+    45287, 45292, 45297, 45302, 45307, 45312, 45317, 45322, 45328, 45333, 45338, 45343,
+    45348, 45353, 45358, 45363, 45368, 45374, 45379, 45384, 45389, 45394, 45399, 45404,
+    45409, 45415, 45420, 45425, 45430, 45435, 45440, 45445, 45450, 45456, 45461, 45466,
+    45471, 45476, 45481, 45486, 45491, 45497, 45502, 45507, 45512, 45517, 45522, 45527,
+    45533, 45538, 45543, 45548, 45553, 45558, 45563, 45568, 45574, 45579, 45584, 45589,
+    45594, 45599, 45604, 45610, 45615, 45620, 45625, 45630, 45635, 45641, 45646, 45651,
+    45656, 45661, 45666, 45671, 45677, 45682, 45687, 45692, 45697, 45702, 45707, 45713,
+    45718, 45723, 45728, 45733, 45738, 45744, 45749, 45754, 45759, 45764, 45769, 45775,
+    45780, 45785, 45790, 45795, 45800, 45806, 45811, 45816, 45821, 45826, 45831, 45837,
+    45842, 45847, 45852, 45857, 45862, 45868, 45873, 45878, 45883, 45888, 45894, 45899,
+    45904, 45909, 45914, 45919, 45925, 45930, 45935, 45940, 45945, 45951, 45956, 45961,
+    45966, 45971, 45976, 45982, 45987, 45992, 45997, 46002, 46008, 46013, 46018, 46023,
+    46028, 46034, 46039, 46044, 46049, 46054, 46059, 46065, 46070, 46075, 46080, 46085,
+    46091, 46096, 46101, 46106, 46111, 46117, 46122, 46127, 46132, 46138, 46143, 46148,
+    46153, 46158, 46164, 46169, 46174, 46179, 46184, 46190, 46195, 46200, 46205, 46210,
+    46216, 46221, 46226, 46231, 46237, 46242, 46247, 46252, 46257, 46263, 46268, 46273,
+    46278, 46283, 46289, 46294, 46299, 46304, 46310, 46315, 46320, 46325, 46330, 46336,
+    46341, 46346, 46351, 46357, 46362, 46367, 46372, 46378, 46383, 46388, 46393, 46398,
+    46404, 46409, 46414, 46419, 46425, 46430, 46435, 46440, 46446, 46451, 46456, 46461,
+    46467, 46472, 46477, 46482, 46488, 46493, 46498, 46503, 46509, 46514, 46519, 46524,
+    46530, 46535, 46540, 46545, 46551, 46556, 46561, 46566, 46572, 46577, 46582, 46587,
+    46593, 46598, 46603, 46608, 46614, 46619, 46624, 46629, 46635, 46640, 46645, 46650,
+    46656, 46661, 46666, 46671, 46677, 46682, 46687, 46693, 46698, 46703, 46708, 46714,
+    46719, 46724, 46729, 46735, 46740, 46745, 46751, 46756, 46761, 46766, 46772, 46777,
+    46782, 46787, 46793, 46798, 46803, 46809, 46814, 46819, 46824, 46830, 46835, 46840,
+    46846, 46851, 46856, 46861, 46867, 46872, 46877, 46883, 46888, 46893, 46898, 46904,
+    46909, 46914, 46920, 46925, 46930, 46936, 46941, 46946, 46951, 46957, 46962, 46967,
+    46973, 46978, 46983, 46988, 46994, 46999, 47004, 47010, 47015, 47020, 47026, 47031,
+    47036, 47042, 47047, 47052, 47057, 47063, 47068, 47073, 47079, 47084, 47089, 47095,
+    47100, 47105, 47111, 47116, 47121, 47127, 47132, 47137, 47142, 47148, 47153, 47158,
+    47164, 47169, 47174, 47180, 47185, 47190, 47196, 47201, 47206, 47212, 47217, 47222,
+    47228, 47233, 47238, 47244, 47249, 47254, 47260, 47265, 47270, 47276, 47281, 47286,
+    47292, 47297, 47302, 47308, 47313, 47318, 47324, 47329, 47334, 47340, 47345, 47350,
+    47356, 47361, 47366, 47372, 47377, 47382, 47388, 47393, 47398, 47404, 47409, 47414,
+    47420, 47425, 47431, 47436, 47441, 47447, 47452, 47457, 47463, 47468, 47473, 47479,
+    47484, 47489, 47495, 47500, 47506, 47511, 47516, 47522, 47527, 47532, 47538, 47543,
+    47548, 47554, 47559, 47565, 47570, 47575, 47581, 47586, 47591, 47597, 47602, 47607,
+    47613, 47618, 47624, 47629, 47634, 47640, 47645, 47650, 47656, 47661, 47667, 47672,
+    47677, 47683, 47688, 47693, 47699, 47704, 47710, 47715, 47720, 47726, 47731, 47737,
+    47742, 47747, 47753, 47758, 47763, 47769, 47774, 47780, 47785, 47790, 47796, 47801,
+    47807, 47812, 47817, 47823, 47828, 47834, 47839, 47844, 47850, 47855, 47861, 47866,
+    47871, 47877, 47882, 47888, 47893, 47898, 47904, 47909, 47915, 47920, 47925, 47931,
+    47936, 47942, 47947, 47952, 47958, 47963, 47969, 47974, 47979, 47985, 47990, 47996,
+    48001, 48007, 48012, 48017, 48023, 48028, 48034, 48039, 48044, 48050, 48055, 48061,
+    48066, 48072, 48077, 48082, 48088, 48093, 48099, 48104, 48110, 48115, 48120, 48126,
+    48131, 48137, 48142, 48148, 48153, 48158, 48164, 48169, 48175, 48180, 48186, 48191,
+    48196, 48202, 48207, 48213, 48218, 48224, 48229, 48235, 48240, 48245, 48251, 48256,
+    48262, 48267, 48273, 48278, 48284, 48289, 48294, 48300, 48305, 48311, 48316, 48322,
+    48327, 48333, 48338, 48344, 48349, 48354, 48360, 48365, 48371, 48376, 48382, 48387,
+    48393, 48398, 48404, 48409, 48414, 48420, 48425, 48431, 48436, 48442, 48447, 48453,
+    48458, 48464, 48469, 48475, 48480, 48486, 48491, 48496, 48502, 48507, 48513, 48518,
+    48524, 48529, 48535, 48540, 48546, 48551, 48557, 48562, 48568, 48573, 48579, 48584,
+    48590, 48595, 48601, 48606, 48612, 48617, 48622, 48628, 48633, 48639, 48644, 48650,
+    48655, 48661, 48666, 48672, 48677, 48683, 48688, 48694, 48699, 48705, 48710, 48716,
+    48721, 48727, 48732, 48738, 48743, 48749, 48754, 48760, 48765, 48771, 48776, 48782,
+    48787, 48793, 48798, 48804, 48809, 48815, 48820, 48826, 48831, 48837, 48842, 48848,
+    48853, 48859, 48864, 48870, 48875, 48881, 48886, 48892, 48898, 48903, 48909, 48914,
+    48920, 48925, 48931, 48936, 48942, 48947, 48953, 48958, 48964, 48969, 48975, 48980,
+    48986, 48991, 48997, 49002, 49008, 49014, 49019, 49025, 49030, 49036, 49041, 49047,
+    49052, 49058, 49063, 49069, 49074, 49080, 49085, 49091, 49097, 49102, 49108, 49113,
+    49119, 49124, 49130, 49135, 49141, 49146, 49152, 49157, 49163, 49169, 49174, 49180,
+    49185, 49191, 49196, 49202, 49207, 49213, 49219, 49224, 49230, 49235, 49241, 49246,
+    49252, 49257, 49263, 49269, 49274, 49280, 49285, 49291, 49296, 49302, 49307, 49313,
+    49319, 49324, 49330, 49335, 49341, 49346, 49352, 49358, 49363, 49369, 49374, 49380,
+    49385, 49391, 49397, 49402, 49408, 49413, 49419, 49424, 49430, 49436, 49441, 49447,
+    49452, 49458, 49463, 49469, 49475, 49480, 49486, 49491, 49497, 49503, 49508, 49514,
+    49519, 49525, 49530, 49536, 49542, 49547, 49553, 49558, 49564, 49570, 49575, 49581,
+    49586, 49592, 49598, 49603, 49609, 49614, 49620, 49626, 49631, 49637, 49642, 49648,
+    49654, 49659, 49665, 49670, 49676, 49682, 49687, 49693, 49698, 49704, 49710, 49715,
+    49721, 49726, 49732, 49738, 49743, 49749, 49754, 49760, 49766, 49771, 49777, 49783,
+    49788, 49794, 49799, 49805, 49811, 49816, 49822, 49828, 49833, 49839, 49844, 49850,
+    49856, 49861, 49867, 49873, 49878, 49884, 49889, 49895, 49901, 49906, 49912, 49918,
+    49923, 49929, 49934, 49940, 49946, 49951, 49957, 49963, 49968, 49974, 49980, 49985,
+    49991, 49996, 50002, 50008, 50013, 50019, 50025, 50030, 50036, 50042, 50047, 50053,
+    50059, 50064, 50070, 50075, 50081, 50087, 50092, 50098, 50104, 50109, 50115, 50121,
+    50126, 50132, 50138, 50143, 50149, 50155, 50160, 50166, 50172, 50177, 50183, 50189,
+    50194, 50200, 50206, 50211, 50217, 50223, 50228, 50234, 50240, 50245, 50251, 50257,
+    50262, 50268, 50274, 50279, 50285, 50291, 50296, 50302, 50308, 50313, 50319, 50325,
+    50330, 50336, 50342, 50347, 50353, 50359, 50364, 50370, 50376, 50381, 50387, 50393,
+    50399, 50404, 50410, 50416, 50421, 50427, 50433, 50438, 50444, 50450, 50455, 50461,
+    50467, 50472, 50478, 50484, 50490, 50495, 50501, 50507, 50512, 50518, 50524, 50529,
+    50535, 50541, 50547, 50552, 50558, 50564, 50569, 50575, 50581, 50587, 50592, 50598,
+    50604, 50609, 50615, 50621, 50626, 50632, 50638, 50644, 50649, 50655, 50661, 50666,
+    50672, 50678, 50684, 50689, 50695, 50701, 50706, 50712, 50718, 50724, 50729, 50735,
+    50741, 50747, 50752, 50758, 50764, 50769, 50775, 50781, 50787, 50792, 50798, 50804,
+    50810, 50815, 50821, 50827, 50833, 50838, 50844, 50850, 50855, 50861, 50867, 50873,
+    50878, 50884, 50890, 50896, 50901, 50907, 50913, 50919, 50924, 50930, 50936, 50942,
+    50947, 50953, 50959, 50965, 50970, 50976, 50982, 50988, 50993, 50999, 51005, 51011,
+    51016, 51022, 51028, 51034, 51039, 51045, 51051, 51057, 51062, 51068, 51074, 51080,
+    51085, 51091, 51097, 51103, 51109, 51114, 51120, 51126, 51132, 51137, 51143, 51149,
+    51155, 51160, 51166, 51172, 51178, 51184, 51189, 51195, 51201, 51207, 51212, 51218,
+    51224, 51230, 51236, 51241, 51247, 51253, 51259, 51264, 51270, 51276, 51282, 51288,
+    51293, 51299, 51305, 51311, 51317, 51322, 51328, 51334, 51340, 51345, 51351, 51357,
+    51363, 51369, 51374, 51380, 51386, 51392, 51398, 51403, 51409, 51415, 51421, 51427,
+    51432, 51438, 51444, 51450, 51456, 51461, 51467, 51473, 51479, 51485, 51490, 51496,
+    51502, 51508, 51514, 51520, 51525, 51531, 51537, 51543, 51549, 51554, 51560, 51566,
+    51572, 51578, 51584, 51589, 51595, 51601, 51607, 51613, 51618, 51624, 51630, 51636,
+    51642, 51648, 51653, 51659, 51665, 51671, 51677, 51683, 51688, 51694, 51700, 51706,
+    51712, 51718, 51723, 51729, 51735, 51741, 51747, 51753, 51758, 51764, 51770, 51776,
+    51782, 51788, 51793, 51799, 51805, 51811, 51817, 51823, 51829, 51834, 51840, 51846,
+    51852, 51858, 51864, 51869, 51875, 51881, 51887, 51893, 51899, 51905, 51910, 51916,
+    51922, 51928, 51934, 51940, 51946, 51951, 51957, 51963, 51969, 51975, 51981, 51987,
+    51992, 51998, 52004, 52010, 52016, 52022, 52028, 52034, 52039, 52045, 52051, 52057,
+    52063, 52069, 52075, 52081, 52086, 52092, 52098, 52104, 52110, 52116, 52122, 52128,
+    52133, 52139, 52145, 52151, 52157, 52163, 52169, 52175, 52181, 52186, 52192, 52198,
+    52204, 52210, 52216, 52222, 52228, 52234, 52239, 52245, 52251, 52257, 52263, 52269,
+    52275, 52281, 52287, 52293, 52298, 52304, 52310, 52316, 52322, 52328, 52334, 52340,
+    52346, 52352, 52357, 52363, 52369, 52375, 52381, 52387, 52393, 52399, 52405, 52411,
+    52417, 52422, 52428, 52434, 52440, 52446, 52452, 52458, 52464, 52470, 52476, 52482,
+    52488, 52493, 52499, 52505, 52511, 52517, 52523, 52529, 52535, 52541, 52547, 52553,
+    52559, 52565, 52571, 52576, 52582, 52588, 52594, 52600, 52606, 52612, 52618, 52624,
+    52630, 52636, 52642, 52648, 52654, 52660, 52665, 52671, 52677, 52683, 52689, 52695,
+    52701, 52707, 52713, 52719, 52725, 52731, 52737, 52743, 52749, 52755, 52761, 52767,
+    52773, 52779, 52784, 52790, 52796, 52802, 52808, 52814, 52820, 52826, 52832, 52838,
+    52844, 52850, 52856, 52862, 52868, 52874, 52880, 52886, 52892, 52898, 52904, 52910,
+    52916, 52922, 52928, 52934, 52940, 52945, 52951, 52957, 52963, 52969, 52975, 52981,
+    52987, 52993, 52999, 53005, 53011, 53017, 53023, 53029, 53035, 53041, 53047, 53053,
+    53059, 53065, 53071, 53077, 53083, 53089, 53095, 53101, 53107, 53113, 53119, 53125,
+    53131, 53137, 53143, 53149, 53155, 53161, 53167, 53173, 53179, 53185, 53191, 53197,
+    53203, 53209, 53215, 53221, 53227, 53233, 53239, 53245, 53251, 53257, 53263, 53269,
+    53275, 53281, 53287, 53293, 53299, 53305, 53311, 53317, 53323, 53329, 53335, 53341,
+    53347, 53353, 53359, 53365, 53371, 53377, 53383, 53389, 53395, 53401, 53407, 53413,
+    53419, 53426, 53432, 53438, 53444, 53450, 53456, 53462, 53468, 53474, 53480, 53486,
+    53492, 53498, 53504, 53510, 53516, 53522, 53528, 53534, 53540, 53546, 53552, 53558,
+    53564, 53570, 53576, 53582, 53588, 53595, 53601, 53607, 53613, 53619, 53625, 53631,
+    53637, 53643, 53649, 53655, 53661, 53667, 53673, 53679, 53685, 53691, 53697, 53703,
+    53710, 53716, 53722, 53728, 53734, 53740, 53746, 53752, 53758, 53764, 53770, 53776,
+    53782, 53788, 53794, 53801, 53807, 53813, 53819, 53825, 53831, 53837, 53843, 53849,
+    53855, 53861, 53867, 53873, 53879, 53886, 53892, 53898, 53904, 53910, 53916, 53922,
+    53928, 53934, 53940, 53946, 53952, 53959, 53965, 53971, 53977, 53983, 53989, 53995,
+    54001, 54007, 54013, 54019, 54026, 54032, 54038, 54044, 54050, 54056, 54062, 54068,
+    54074, 54080, 54087, 54093, 54099, 54105, 54111, 54117, 54123, 54129, 54135, 54141,
+    54148, 54154, 54160, 54166, 54172, 54178, 54184, 54190, 54196, 54203, 54209, 54215,
+    54221, 54227, 54233, 54239, 54245, 54252, 54258, 54264, 54270, 54276, 54282, 54288,
+    54294, 54301, 54307, 54313, 54319, 54325, 54331, 54337, 54343, 54350, 54356, 54362,
+    54368, 54374, 54380, 54386, 54392, 54399, 54405, 54411, 54417, 54423, 54429, 54435,
+    54442, 54448, 54454, 54460, 54466, 54472, 54478, 54485, 54491, 54497, 54503, 54509,
+    54515, 54522, 54528, 54534, 54540, 54546, 54552, 54558, 54565, 54571, 54577, 54583,
+    54589, 54595, 54602, 54608, 54614, 54620, 54626, 54632, 54638, 54645, 54651, 54657,
+    54663, 54669, 54675, 54682, 54688, 54694, 54700, 54706, 54713, 54719, 54725, 54731,
+    54737, 54743, 54750, 54756, 54762, 54768, 54774, 54780, 54787, 54793, 54799, 54805,
+    54811, 54818, 54824, 54830, 54836, 54842, 54848, 54855, 54861, 54867, 54873, 54879,
+    54886, 54892, 54898, 54904, 54910, 54917, 54923, 54929, 54935, 54941, 54948, 54954,
+    54960, 54966, 54972, 54979, 54985, 54991, 54997, 55003, 55010, 55016, 55022, 55028,
+    55034, 55041, 55047, 55053, 55059, 55065, 55072, 55078, 55084, 55090, 55097, 55103,
+    55109, 55115, 55121, 55128, 55134, 55140, 55146, 55153, 55159, 55165, 55171, 55177,
+    55184, 55190, 55196, 55202, 55209, 55215, 55221, 55227, 55233, 55240, 55246, 55252,
+    55258, 55265, 55271, 55277, 55283, 55290, 55296, 55302, 55308, 55315, 55321, 55327,
+    55333, 55340, 55346, 55352, 55358, 55364, 55371, 55377, 55383, 55389, 55396, 55402,
+    55408, 55414, 55421, 55427, 55433, 55439, 55446, 55452, 55458, 55465, 55471, 55477,
+    55483, 55490, 55496, 55502, 55508, 55515, 55521, 55527, 55533, 55540, 55546, 55552,
+    55558, 55565, 55571, 55577, 55584, 55590, 55596, 55602, 55609, 55615, 55621, 55627,
+    55634, 55640, 55646, 55653, 55659, 55665, 55671, 55678, 55684, 55690, 55697, 55703,
+    55709, 55715, 55722, 55728, 55734, 55741, 55747, 55753, 55759, 55766, 55772, 55778,
+    55785, 55791, 55797, 55803, 55810, 55816, 55822, 55829, 55835, 55841, 55848, 55854,
+    55860, 55866, 55873, 55879, 55885, 55892, 55898, 55904, 55911, 55917, 55923, 55929,
+    55936, 55942, 55948, 55955, 55961, 55967, 55974, 55980, 55986, 55993, 55999, 56005,
+    56012, 56018, 56024, 56031, 56037, 56043, 56050, 56056, 56062, 56068, 56075, 56081,
+    56087, 56094, 56100, 56106, 56113, 56119, 56125, 56132, 56138, 56144, 56151, 56157,
+    56163, 56170, 56176, 56182, 56189, 56195, 56201, 56208, 56214, 56220, 56227, 56233,
+    56240, 56246, 56252, 56259, 56265, 56271, 56278, 56284, 56290, 56297, 56303, 56309,
+    56316, 56322, 56328, 56335, 56341, 56347, 56354, 56360, 56367, 56373, 56379, 56386,
+    56392, 56398, 56405, 56411, 56417, 56424, 56430, 56437, 56443, 56449, 56456, 56462,
+    56468, 56475, 56481, 56488, 56494, 56500, 56507, 56513, 56519, 56526, 56532, 56539,
+    56545, 56551, 56558, 56564, 56570, 56577, 56583, 56590, 56596, 56602, 56609, 56615,
+    56622, 56628, 56634, 56641, 56647, 56653, 56660, 56666, 56673, 56679, 56685, 56692,
+    56698, 56705, 56711, 56717, 56724, 56730, 56737, 56743, 56749, 56756, 56762, 56769,
+    56775, 56781, 56788, 56794, 56801, 56807, 56813, 56820, 56826, 56833, 56839, 56846,
+    56852, 56858, 56865, 56871, 56878, 56884, 56890, 56897, 56903, 56910, 56916, 56923,
+    56929, 56935, 56942, 56948, 56955, 56961, 56968, 56974, 56980, 56987, 56993, 57000,
+    57006, 57013, 57019, 57025, 57032, 57038, 57045, 57051, 57058, 57064, 57070, 57077,
+    57083, 57090, 57096, 57103, 57109, 57116, 57122, 57128, 57135, 57141, 57148, 57154,
+    57161, 57167, 57174, 57180, 57186, 57193, 57199, 57206, 57212, 57219, 57225, 57232,
+    57238, 57245, 57251, 57257, 57264, 57270, 57277, 57283, 57290, 57296, 57303, 57309,
+    57316, 57322, 57329, 57335, 57341, 57348, 57354, 57361, 57367, 57374, 57380, 57387,
+    57393, 57400, 57406, 57413, 57419, 57426, 57432, 57439, 57445, 57452, 57458, 57465,
+    57471, 57478, 57484, 57490, 57497, 57503, 57510, 57516, 57523, 57529, 57536, 57542,
+    57549, 57555, 57562, 57568, 57575, 57581, 57588, 57594, 57601, 57607, 57614, 57620,
+    57627, 57633, 57640, 57646, 57653, 57659, 57666, 57672, 57679, 57685, 57692, 57698,
+    57705, 57711, 57718, 57724, 57731, 57737, 57744, 57750, 57757, 57764, 57770, 57777,
+    57783, 57790, 57796, 57803, 57809, 57816, 57822, 57829, 57835, 57842, 57848, 57855,
+    57861, 57868, 57874, 57881, 57887, 57894, 57901, 57907, 57914, 57920, 57927, 57933,
+    57940, 57946, 57953, 57959, 57966, 57972, 57979, 57986, 57992, 57999, 58005, 58012,
+    58018, 58025, 58031, 58038, 58044, 58051, 58058, 58064, 58071, 58077, 58084, 58090,
+    58097, 58103, 58110, 58117, 58123, 58130, 58136, 58143, 58149, 58156, 58162, 58169,
+    58176, 58182, 58189, 58195, 58202, 58208, 58215, 58222, 58228, 58235, 58241, 58248,
+    58254, 58261, 58267, 58274, 58281, 58287, 58294, 58300, 58307, 58314, 58320, 58327,
+    58333, 58340, 58346, 58353, 58360, 58366, 58373, 58379, 58386, 58393, 58399, 58406,
+    58412, 58419, 58425, 58432, 58439, 58445, 58452, 58458, 58465, 58472, 58478, 58485,
+    58491, 58498, 58505, 58511, 58518, 58524, 58531, 58538, 58544, 58551, 58557, 58564,
+    58571, 58577, 58584, 58590, 58597, 58604, 58610, 58617, 58624, 58630, 58637, 58643,
+    58650, 58657, 58663, 58670, 58676, 58683, 58690, 58696, 58703, 58710, 58716, 58723,
+    58729, 58736, 58743, 58749, 58756, 58763, 58769, 58776, 58782, 58789, 58796, 58802,
+    58809, 58816, 58822, 58829, 58836, 58842, 58849, 58855, 58862, 58869, 58875, 58882,
+    58889, 58895, 58902, 58909, 58915, 58922, 58929, 58935, 58942, 58949, 58955, 58962,
+    58968, 58975, 58982, 58988, 58995, 59002, 59008, 59015, 59022, 59028, 59035, 59042,
+    59048, 59055, 59062, 59068, 59075, 59082, 59088, 59095, 59102, 59108, 59115, 59122,
+    59128, 59135, 59142, 59148, 59155, 59162, 59168, 59175, 59182, 59188, 59195, 59202,
+    59208, 59215, 59222, 59229, 59235, 59242, 59249, 59255, 59262, 59269, 59275, 59282,
+    59289, 59295, 59302, 59309, 59315, 59322, 59329, 59336, 59342, 59349, 59356, 59362,
+    59369, 59376, 59382, 59389, 59396, 59402, 59409, 59416, 59423, 59429, 59436, 59443,
+    59449, 59456, 59463, 59470, 59476, 59483, 59490, 59496, 59503, 59510, 59517, 59523,
+    59530, 59537, 59543, 59550, 59557, 59564, 59570, 59577, 59584, 59590, 59597, 59604,
+    59611, 59617, 59624, 59631, 59638, 59644, 59651, 59658, 59664, 59671, 59678, 59685,
+    59691, 59698, 59705, 59712, 59718, 59725, 59732, 59739, 59745, 59752, 59759, 59765,
+    59772, 59779, 59786, 59792, 59799, 59806, 59813, 59819, 59826, 59833, 59840, 59846,
+    59853, 59860, 59867, 59873, 59880, 59887, 59894, 59900, 59907, 59914, 59921, 59928,
+    59934, 59941, 59948, 59955, 59961, 59968, 59975, 59982, 59988, 59995, 60002, 60009,
+    60015, 60022, 60029, 60036, 60043, 60049, 60056, 60063, 60070, 60076, 60083, 60090,
+    60097, 60104, 60110, 60117, 60124, 60131, 60137, 60144, 60151, 60158, 60165, 60171,
+    60178, 60185, 60192, 60199, 60205, 60212, 60219, 60226, 60233, 60239, 60246, 60253,
+    60260, 60267, 60273, 60280, 60287, 60294, 60301, 60307, 60314, 60321, 60328, 60335,
+    60341, 60348, 60355, 60362, 60369, 60375, 60382, 60389, 60396, 60403, 60409, 60416,
+    60423, 60430, 60437, 60444, 60450, 60457, 60464, 60471, 60478, 60484, 60491, 60498,
+    60505, 60512, 60519, 60525, 60532, 60539, 60546, 60553, 60560, 60566, 60573, 60580,
+    60587, 60594, 60601, 60607, 60614, 60621, 60628, 60635, 60642, 60648, 60655, 60662,
+    60669, 60676, 60683, 60690, 60696, 60703, 60710, 60717, 60724, 60731, 60737, 60744,
+    60751, 60758, 60765, 60772, 60779, 60785, 60792, 60799, 60806, 60813, 60820, 60827,
+    60833, 60840, 60847, 60854, 60861, 60868, 60875, 60882, 60888, 60895, 60902, 60909,
+    60916, 60923, 60930, 60937, 60943, 60950, 60957, 60964, 60971, 60978, 60985, 60992,
+    60998, 61005, 61012, 61019, 61026, 61033, 61040, 61047, 61054, 61060, 61067, 61074,
+    61081, 61088, 61095, 61102, 61109, 61116, 61122, 61129, 61136, 61143, 61150, 61157,
+    61164, 61171, 61178, 61185, 61191, 61198, 61205, 61212, 61219, 61226, 61233, 61240,
+    61247, 61254, 61260, 61267, 61274, 61281, 61288, 61295, 61302, 61309, 61316, 61323,
+    61330, 61337, 61343, 61350, 61357, 61364, 61371, 61378, 61385, 61392, 61399, 61406,
+    61413, 61420, 61427, 61434, 61440, 61447, 61454, 61461, 61468, 61475, 61482, 61489,
+    61496, 61503, 61510, 61517, 61524, 61531, 61538, 61545, 61551, 61558, 61565, 61572,
+    61579, 61586, 61593, 61600, 61607, 61614, 61621, 61628, 61635, 61642, 61649, 61656,
+    61663, 61670, 61677, 61684, 61690, 61697, 61704, 61711, 61718, 61725, 61732, 61739,
+    61746, 61753, 61760, 61767, 61774, 61781, 61788, 61795, 61802, 61809, 61816, 61823,
+    61830, 61837, 61844, 61851, 61858, 61865, 61872, 61879, 61886, 61893, 61900, 61907,
+    61914, 61921, 61928, 61935, 61942, 61949, 61956, 61963, 61970, 61976, 61983, 61990,
+    61997, 62004, 62011, 62018, 62025, 62032, 62039, 62046, 62053, 62060, 62067, 62074,
+    62081, 62088, 62095, 62102, 62109, 62116, 62124, 62131, 62138, 62145, 62152, 62159,
+    62166, 62173, 62180, 62187, 62194, 62201, 62208, 62215, 62222, 62229, 62236, 62243,
+    62250, 62257, 62264, 62271, 62278, 62285, 62292, 62299, 62306, 62313, 62320, 62327,
+    62334, 62341, 62348, 62355, 62362, 62369, 62376, 62383, 62390, 62397, 62404, 62412,
+    62419, 62426, 62433, 62440, 62447, 62454, 62461, 62468, 62475, 62482, 62489, 62496,
+    62503, 62510, 62517, 62524, 62531, 62538, 62545, 62553, 62560, 62567, 62574, 62581,
+    62588, 62595, 62602, 62609, 62616, 62623, 62630, 62637, 62644, 62651, 62658, 62666,
+    62673, 62680, 62687, 62694, 62701, 62708, 62715, 62722, 62729, 62736, 62743, 62750,
+    62757, 62765, 62772, 62779, 62786, 62793, 62800, 62807, 62814, 62821, 62828, 62835,
+    62843, 62850, 62857, 62864, 62871, 62878, 62885, 62892, 62899, 62906, 62913, 62921,
+    62928, 62935, 62942, 62949, 62956, 62963, 62970, 62977, 62984, 62992, 62999, 63006,
+    63013, 63020, 63027, 63034, 63041, 63048, 63056, 63063, 63070, 63077, 63084, 63091,
+    63098, 63105, 63112, 63120, 63127, 63134, 63141, 63148, 63155, 63162, 63169, 63177,
+    63184, 63191, 63198, 63205, 63212, 63219, 63227, 63234, 63241, 63248, 63255, 63262,
+    63269, 63276, 63284, 63291, 63298, 63305, 63312, 63319, 63326, 63334, 63341, 63348,
+    63355, 63362, 63369, 63376, 63384, 63391, 63398, 63405, 63412, 63419, 63427, 63434,
+    63441, 63448, 63455, 63462, 63470, 63477, 63484, 63491, 63498, 63505, 63512, 63520,
+    63527, 63534, 63541, 63548, 63555, 63563, 63570, 63577, 63584, 63591, 63599, 63606,
+    63613, 63620, 63627, 63634, 63642, 63649, 63656, 63663, 63670, 63678, 63685, 63692,
+    63699, 63706, 63713, 63721, 63728, 63735, 63742, 63749, 63757, 63764, 63771, 63778,
+    63785, 63793, 63800, 63807, 63814, 63821, 63829, 63836, 63843, 63850, 63857, 63865,
+    63872, 63879, 63886, 63893, 63901, 63908, 63915, 63922, 63929, 63937, 63944, 63951,
+    63958, 63966, 63973, 63980, 63987, 63994, 64002, 64009, 64016, 64023, 64030, 64038,
+    64045, 64052, 64059, 64067, 64074, 64081, 64088, 64096, 64103, 64110, 64117, 64124,
+    64132, 64139, 64146, 64153, 64161, 64168, 64175, 64182, 64190, 64197, 64204, 64211,
+    64219, 64226, 64233, 64240, 64248, 64255, 64262, 64269, 64277, 64284, 64291, 64298,
+    64306, 64313, 64320, 64327, 64335, 64342, 64349, 64356, 64364, 64371, 64378, 64385,
+    64393, 64400, 64407, 64414, 64422, 64429, 64436, 64444, 64451, 64458, 64465, 64473,
+    64480, 64487, 64494, 64502, 64509, 64516, 64524, 64531, 64538, 64545, 64553, 64560,
+    64567, 64575, 64582, 64589, 64596, 64604, 64611, 64618, 64626, 64633, 64640, 64647,
+    64655, 64662, 64669, 64677, 64684, 64691, 64699, 64706, 64713, 64720, 64728, 64735,
+    64742, 64750, 64757, 64764, 64772, 64779, 64786, 64793, 64801, 64808, 64815, 64823,
+    64830, 64837, 64845, 64852, 64859, 64867, 64874, 64881, 64889, 64896, 64903, 64911,
+    64918, 64925, 64933, 64940, 64947, 64955, 64962, 64969, 64976, 64984, 64991, 64998,
+    65006, 65013, 65020, 65028, 65035, 65042, 65050, 65057, 65065, 65072, 65079, 65087,
+    65094, 65101, 65109, 65116, 65123, 65131, 65138, 65145, 65153, 65160, 65167, 65175,
+    65182, 65189, 65197, 65204, 65211, 65219, 65226, 65234, 65241, 65248, 65256, 65263,
+    65270, 65278, 65285, 65292, 65300, 65307, 65315, 65322, 65329, 65337, 65344, 65351,
+    65359, 65366, 65374, 65381, 65388, 65396, 65403, 65410, 65418, 65425, 65433, 65440,
+    65447, 65455, 65462, 65469, 65477, 65484, 65492, 65499, 65506, 65514, 65521, 65529
+};